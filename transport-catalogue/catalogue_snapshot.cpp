@@ -0,0 +1,59 @@
+#include "catalogue_snapshot.h"
+
+#include <thread>
+#include <utility>
+
+namespace transport_catalog {
+
+    SnapshotHolder::Reader::Reader(Reader&& other) noexcept
+        : snapshot_(std::exchange(other.snapshot_, nullptr))
+        , readers_(std::exchange(other.readers_, nullptr))
+    {}
+
+    SnapshotHolder::Reader::~Reader() {
+        if (readers_) {
+            readers_->fetch_sub(1);
+        }
+    }
+
+    SnapshotHolder::SnapshotHolder() {
+        // пустой снимок строится без рабочих потоков
+        TaskPool inline_pool(0);
+        auto snapshot = std::make_unique<CatalogueSnapshot>();
+        snapshot->catalogue.Freeze(inline_pool);
+        snapshot->router.BuildGraph(snapshot->catalogue, inline_pool);
+        current_ = snapshot.release();
+    }
+
+    SnapshotHolder::~SnapshotHolder() {
+        delete current_.load();
+    }
+
+    SnapshotHolder::Reader SnapshotHolder::Acquire() const {
+        while (true) {
+            const size_t epoch = epoch_.load();
+            std::atomic<size_t>& readers = readers_[epoch % 2];
+            readers.fetch_add(1);
+            // если эпоху успели сменить, писатель мог не увидеть читателя - отметка делается заново
+            if (epoch_.load() == epoch) {
+                return Reader(current_.load(), &readers);
+            }
+            readers.fetch_sub(1);
+        }
+    }
+
+    void SnapshotHolder::Publish(std::unique_ptr<const CatalogueSnapshot> snapshot) {
+        std::lock_guard lock(publish_mutex_);
+
+        const CatalogueSnapshot* old_snapshot = current_.exchange(snapshot.release());
+        // новые читатели отмечаются в другой эпохе и видят уже новый снимок,
+        // старый снимок могут держать только читатели прошлой эпохи
+        const size_t old_epoch = epoch_.fetch_add(1);
+        while (readers_[old_epoch % 2].load() != 0) {
+            std::this_thread::yield();
+        }
+
+        delete old_snapshot;
+    }
+
+}   // namespace transport_catalog
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "transport_catalogue.h"
+#include "map_renderer.h"
+#include "transport_router.h"
+
+namespace transport_catalog {
+
+    // Согласованный набор данных, по которому отвечают на запросы:
+    // каталог, настройки карты и маршрутизатор с построенным графом.
+    // После публикации в SnapshotHolder не изменяется
+    struct CatalogueSnapshot {
+        TransportCatalogue catalogue;
+        renderer::MapRenderer renderer;
+        TransportRouter router;
+    };
+
+    // Хранит текущий снимок каталога.
+    // Читатели берут снимок без блокировок: отмечаются в счетчике своей эпохи и читают атомарный указатель.
+    // Писатель подменяет указатель, переключает эпоху и освобождает старый снимок,
+    // когда уйдут читатели прошлой эпохи, поэтому начатые запросы дочитывают старый снимок
+    class SnapshotHolder {
+    public:
+        // Снимок, удерживаемый читателем. Пока Reader жив, снимок не освобождается
+        class Reader {
+        public:
+            Reader(Reader&& other) noexcept;
+            Reader& operator=(Reader&&) = delete;
+            ~Reader();
+
+            const CatalogueSnapshot& operator*() const { return *snapshot_; }
+            const CatalogueSnapshot* operator->() const { return snapshot_; }
+
+        private:
+            friend class SnapshotHolder;
+
+            Reader(const CatalogueSnapshot* snapshot, std::atomic<size_t>* readers)
+                : snapshot_(snapshot)
+                , readers_(readers)
+            {}
+
+            const CatalogueSnapshot* snapshot_;
+            std::atomic<size_t>* readers_; // счетчик эпохи, в которой отмечен читатель
+        };
+
+        // создает хранилище с пустым готовым к чтению снимком
+        SnapshotHolder();
+        ~SnapshotHolder();
+
+        SnapshotHolder(const SnapshotHolder&) = delete;
+        SnapshotHolder& operator=(const SnapshotHolder&) = delete;
+
+        // возвращает текущий снимок, не блокируясь
+        Reader Acquire() const;
+        // заменяет текущий снимок новым и ждет, пока старый отпустят все читатели.
+        // Поток, удерживающий Reader, вызывать Publish не должен: он ждал бы сам себя
+        void Publish(std::unique_ptr<const CatalogueSnapshot> snapshot);
+
+    private:
+        std::atomic<const CatalogueSnapshot*> current_{ nullptr };
+        std::atomic<size_t> epoch_{ 0 };
+        mutable std::atomic<size_t> readers_[2] = { {0}, {0} }; // читатели четной и нечетной эпохи
+        std::mutex publish_mutex_; // писатели публикуют снимки по одному
+    };
+
+}   // namespace transport_catalog
@@ -2,20 +2,50 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "geo.h"
 
 namespace transport_catalog {
 
     struct Stop {
-        std::string name{};
+        std::string_view name{}; // указывает в хранилище имен каталога
         geo::Coordinates coordinates{};
+        size_t id{ 0 }; // порядковый номер остановки в каталоге
+        std::string_view json_name{}; // имя в кавычках и с экранированием для вывода в JSON, заполняется в Freeze
+    };
+
+    // непрерывный участок массива остановок, принадлежащий одному маршруту
+    class StopsSpan {
+    public:
+        StopsSpan() = default;
+        StopsSpan(Stop* const* data, size_t size)
+            : data_(data)
+            , size_(size)
+        {}
+
+        Stop* const* begin() const { return data_; }
+        Stop* const* end() const { return data_ + size_; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        Stop* front() const { return data_[0]; }
+        Stop* back() const { return data_[size_ - 1]; }
+        Stop* operator[](size_t index) const { return data_[index]; }
+
+    private:
+        Stop* const* data_ = nullptr;
+        size_t size_ = 0;
     };
 
     struct Bus {
-        std::string name{};
-        std::vector<Stop*> stops{};
+        std::string_view name{}; // указывает в хранилище имен каталога
+        StopsSpan stops{};
         bool is_roundtrip{ false };
+        std::string_view json_name{}; // имя в кавычках и с экранированием для вывода в JSON, заполняется в Freeze
+        // статистика маршрута туда и обратно, заполняется в Freeze
+        double route_length{ 0. }; // по дорожным расстояниям
+        double geo_route_length{ 0. }; // по прямой между остановками
+        size_t unique_stop_count{ 0 };
     };
 
     struct StopHasher {
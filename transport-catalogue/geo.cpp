@@ -11,14 +11,59 @@ namespace transport_catalog {
         double ComputeDistance(Coordinates from, Coordinates to) {
             using namespace std;
 
-            const size_t RADIUS_OF_EARTH = 6371000;
             if (from == to) {
                 return 0;
             }
             static const double dr = M_PI / 180.;
             return acos(sin(from.lat * dr) * sin(to.lat * dr)
                 + cos(from.lat * dr) * cos(to.lat * dr) * cos(abs(from.lng - to.lng) * dr))
-                * RADIUS_OF_EARTH;
+                * EARTH_RADIUS;
+        }
+
+        PreparedCoordinates PrepareCoordinates(Coordinates point) {
+            static const double dr = M_PI / 180.;
+            return { point, std::sin(point.lat * dr), std::cos(point.lat * dr) };
+        }
+
+        double ComputeDistance(const PreparedCoordinates& from, const PreparedCoordinates& to) {
+            double distance = 0.;
+            ComputeDistances(&from, &to, 1, &distance);
+            return distance;
+        }
+
+        // Расчет разбит на проходы по массивам: косинусы разности долгот, затем умножения и сложения
+        // (этот проход компилятор векторизует), затем арккосинусы.
+        // Порядок операций тот же, что в ComputeDistance(Coordinates, Coordinates), поэтому результат совпадает побитно
+        void ComputeDistances(const PreparedCoordinates* from, const PreparedCoordinates* to, size_t count, double* distances) {
+            static const double dr = M_PI / 180.;
+
+            for (size_t i = 0; i < count; ++i) {
+                distances[i] = std::cos(std::abs(from[i].coordinates.lng - to[i].coordinates.lng) * dr);
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                distances[i] = from[i].sin_lat * to[i].sin_lat + from[i].cos_lat * to[i].cos_lat * distances[i];
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                distances[i] = (from[i].coordinates == to[i].coordinates) ? 0. : std::acos(distances[i]) * EARTH_RADIUS;
+            }
+        }
+
+        void ComputeDistances(const PreparedCoordinates& from, const PreparedCoordinates* to, size_t count, double* distances) {
+            static const double dr = M_PI / 180.;
+
+            for (size_t i = 0; i < count; ++i) {
+                distances[i] = std::cos(std::abs(from.coordinates.lng - to[i].coordinates.lng) * dr);
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                distances[i] = from.sin_lat * to[i].sin_lat + from.cos_lat * to[i].cos_lat * distances[i];
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                distances[i] = (from.coordinates == to[i].coordinates) ? 0. : std::acos(distances[i]) * EARTH_RADIUS;
+            }
         }
 
 
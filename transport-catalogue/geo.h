@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstddef>
+
 namespace transport_catalog {
 
     namespace geo {
 
-        
+        inline constexpr double EARTH_RADIUS = 6371000.; // радиус Земли в метрах
+
         struct Coordinates {
             double lat; // Широта
             double lng; // Долгота
@@ -16,8 +19,24 @@ namespace transport_catalog {
             }
         };
 
+        // координаты вместе с заранее посчитанными синусом и косинусом широты
+        struct PreparedCoordinates {
+            Coordinates coordinates;
+            double sin_lat = 0.;
+            double cos_lat = 1.;
+        };
+
         double ComputeDistance(Coordinates from, Coordinates to);
 
+        // считает синус и косинус широты точки
+        PreparedCoordinates PrepareCoordinates(Coordinates point);
+        // расстояние между подготовленными точками, совпадает с ComputeDistance до последнего бита
+        double ComputeDistance(const PreparedCoordinates& from, const PreparedCoordinates& to);
+        // расстояния между парами точек: distances[i] - от from[i] до to[i], i < count
+        void ComputeDistances(const PreparedCoordinates* from, const PreparedCoordinates* to, size_t count, double* distances);
+        // расстояния от одной точки до многих: distances[i] - от from до to[i], i < count
+        void ComputeDistances(const PreparedCoordinates& from, const PreparedCoordinates* to, size_t count, double* distances);
+
 
     }  // namespace geo
 
@@ -1,4 +1,7 @@
 #include "json.h"
+#include "json_scan.h"
+
+#include <charconv>
 
 using namespace std;
 
@@ -6,223 +9,339 @@ namespace json {
 
 namespace {
 
-Node LoadNode(istream& input);
+// Разбирает JSON из непрерывного буфера, двигая указатель по символам, и сообщает о прочитанном обработчику.
+// Строки без escape-последовательностей передаются обработчику прямо из буфера, без копирования.
+// Поток читается блоками: буфер дочитывается, когда разбор доходит до его конца, а недочитанное
+// число, строка или литерал переносятся в начало буфера. Поэтому события приходят по мере поступления
+// данных, а память не зависит от размера документа.
+// Тип обработчика - параметр шаблона, чтобы при сборке дерева вызовы не были виртуальными
+template <typename EventHandler>
+class Parser {
+public:
+    Parser(const char* begin, const char* end, EventHandler& handler)
+        : pos_(begin)
+        , end_(end)
+        , handler_(handler) {
+    }
+
+    Parser(istream& input, EventHandler& handler)
+        : input_(&input)
+        , chunk_(CHUNK_SIZE, '\0')
+        , handler_(handler) {
+    }
 
-Node LoadArray(istream& input) {
-    Array result;
+    void LoadNode() {
+        const char c = PeekToken();
 
-    for (char c; input >> c && c != ']';) {
-        if (c != ',') {
-            input.putback(c);
+        if (c == '[') {
+            ++pos_;
+            LoadArray();
+        }
+        else if (c == '{') {
+            ++pos_;
+            LoadDict();
+        }
+        else if (c == '"') {
+            ++pos_;
+            handler_.String(LoadString());
+        }
+        else if (c == 'n') { //null
+            CheckValue("null"sv);
+            handler_.Null();
+        }
+        else if (c == 't') { //true
+            CheckValue("true"sv);
+            handler_.Bool(true);
+        }
+        else if (c == 'f') { //false
+            CheckValue("false"sv);
+            handler_.Bool(false);
+        }
+        else {
+            LoadNumber();
         }
-        result.push_back(LoadNode(input));
     }
 
-    return Node(move(result));
-}
-
-Node LoadInt(istream& input) {
-    using namespace std::literals;
+    // Возвращает в поток прочитанный, но не разобранный текст после документа.
+    // Непрочитанный остаток всегда лежит в последнем блоке, а блок целиком взят из текущего буфера потока,
+    // поэтому символы возвращаются в буфер потока без повторного чтения
+    void ReturnUnread() {
+        if (input_ == nullptr) {
+            return;
+        }
+        for (; pos_ != end_; --end_) {
+            if (!input_->unget()) {
+                break;
+            }
+        }
+    }
 
-    std::string parsed_num;
+private:
+    static constexpr size_t CHUNK_SIZE = 1 << 16;
+
+    const char* pos_ = nullptr;
+    const char* end_ = nullptr;
+    istream* input_ = nullptr;  // при разборе из памяти не задан
+    string chunk_;              // место для очередного блока из потока
+    string buffer_;             // прочитанный из потока и еще не разобранный текст
+    string scratch_;            // строка с escape-последовательностями или из нескольких блоков, память переиспользуется
+    EventHandler& handler_;
+
+    // Дочитывает из потока следующий блок: ждет хотя бы один символ и забирает то, что уже есть в буфере потока,
+    // но не больше CHUNK_SIZE. Поэтому на интерактивном вводе разбор не ждет данных, которые еще не пришли.
+    // Текст начиная с keep (не дальше pos_) переносится в начало буфера, keep и pos_ сдвигаются вместе с ним.
+    // Возвращает false, если читать больше нечего
+    bool Fill(const char*& keep) {
+        if (input_ == nullptr || !*input_) {
+            return false;
+        }
 
-    // Считывает в parsed_num очередной символ из input
-    auto read_char = [&parsed_num, &input] {
-        parsed_num += static_cast<char>(input.get());
-        if (!input) {
-            throw ParsingError("Failed to read number from stream"s);
+        const int first = input_->get();
+        if (first == char_traits<char>::eof()) {
+            return false;
         }
-    };
+        chunk_[0] = static_cast<char>(first);
+        const size_t read = 1 + static_cast<size_t>(input_->readsome(chunk_.data() + 1, CHUNK_SIZE - 1));
 
-    // Считывает одну или более цифр в parsed_num из input
-    auto read_digits = [&input, read_char] {
-        if (!std::isdigit(input.peek())) {
-            throw ParsingError("A digit is expected"s);
+        const size_t pos_offset = pos_ - keep;
+        if (keep != end_) {
+            buffer_.erase(0, keep - buffer_.data());
         }
-        while (std::isdigit(input.peek())) {
-            read_char();
+        else {
+            buffer_.clear();
         }
-    };
+        buffer_.append(chunk_.data(), read);
 
-    if (input.peek() == '-') {
-        read_char();
-    }
-    // Парсим целую часть числа
-    if (input.peek() == '0') {
-        read_char();
-        // После 0 в JSON не могут идти другие цифры
+        keep = buffer_.data();
+        pos_ = keep + pos_offset;
+        end_ = buffer_.data() + buffer_.size();
+        return true;
     }
-    else {
-        read_digits();
+
+    static bool IsDigit(char c) {
+        return c >= '0' && c <= '9';
     }
 
-    bool is_int = true;
-    // Парсим дробную часть числа
-    if (input.peek() == '.') {
-        read_char();
-        read_digits();
-        is_int = false;
+    // пропускает пробелы и возвращает следующий символ, не считывая его
+    char PeekToken() {
+        pos_ = detail::SkipSpaces(pos_, end_);
+        while (pos_ == end_ && Fill(pos_)) {
+            pos_ = detail::SkipSpaces(pos_, end_);
+        }
+        if (pos_ == end_) {
+            throw ParsingError("Unexpected end of input"s);
+        }
+        return *pos_;
     }
 
-    // Парсим экспоненциальную часть числа
-    if (int ch = input.peek(); ch == 'e' || ch == 'E') {
-        read_char();
-        if (ch = input.peek(); ch == '+' || ch == '-') {
-            read_char();
+    void LoadArray() {
+        handler_.StartArray();
+
+        if (PeekToken() == ']') {
+            ++pos_;
+            handler_.EndArray();
+            return;
         }
-        read_digits();
-        is_int = false;
+
+        while (true) {
+            LoadNode();
+
+            const char c = PeekToken();
+            ++pos_;
+            if (c == ']') {
+                break;
+            }
+            if (c != ',') {
+                throw ParsingError("Expected ',' or ']' in array"s);
+            }
+        }
+
+        handler_.EndArray();
     }
 
-    try {
-        if (is_int) {
-            // Сначала пробуем преобразовать строку в int
-            try {
-                return Node(std::stoi(parsed_num));
+    void LoadDict() {
+        handler_.StartDict();
+
+        if (PeekToken() == '}') {
+            ++pos_;
+            handler_.EndDict();
+            return;
+        }
+
+        while (true) {
+            if (PeekToken() != '"') {
+                throw ParsingError("Expected string key in dict"s);
             }
-            catch (...) {
-                // В случае неудачи, например, при переполнении,
-                // код ниже попробует преобразовать строку в double
+            ++pos_;
+            handler_.Key(LoadString());
+
+            if (PeekToken() != ':') {
+                throw ParsingError("Expected ':' in dict"s);
+            }
+            ++pos_;
+
+            LoadNode();
+
+            const char c = PeekToken();
+            ++pos_;
+            if (c == '}') {
+                break;
+            }
+            if (c != ',') {
+                throw ParsingError("Expected ',' or '}' in dict"s);
             }
         }
-        return Node(std::stod(parsed_num));
+
+        handler_.EndDict();
     }
-    catch (...) {
-        throw ParsingError("Failed to convert "s + parsed_num + " to number"s);
+
+    // возвращает обычные символы до кавычки, escape-последовательности или конца строки
+    string_view ScanPlain() {
+        const char* start = pos_;
+        pos_ = detail::FindStringSpecial(pos_, end_);
+        return string_view(start, pos_ - start);
     }
-    
-}
 
-Node LoadString(istream& input) {
-    using namespace std::literals;
-    
-    auto it = std::istreambuf_iterator<char>(input);
-    auto end = std::istreambuf_iterator<char>();
-    string line;
-    
-    while (true) {
-        if (it == end) {
-            // Поток закончился до того, как встретили закрывающую кавычку?
-            throw ParsingError("String parsing error");
-        }
-        const char ch = *it;
-        if (ch == '"') {
-            // Встретили закрывающую кавычку
-            ++it;
-            break;
+    // Считывает строку после открывающей кавычки. Строка без escape-последовательностей,
+    // целиком лежащая в буфере, возвращается без копирования, остальные собираются в scratch_.
+    // Результат действителен до следующего чтения разборщиком
+    string_view LoadString() {
+        using namespace std::literals;
+
+        const string_view plain = ScanPlain();
+        if (pos_ != end_ && *pos_ == '"') {
+            ++pos_;
+            return plain;
         }
-        else if (ch == '\\') {
-            // Встретили начало escape-последовательности
-            ++it;
-            if (it == end) {
-                // Поток завершился сразу после символа обратной косой черты
+
+        scratch_.assign(plain);
+        while (true) {
+            if (pos_ == end_) {
+                if (Fill(pos_)) {
+                    scratch_ += ScanPlain();
+                    continue;
+                }
+                // Поток закончился до того, как встретили закрывающую кавычку?
                 throw ParsingError("String parsing error");
             }
-            const char escaped_char = *(it);
-            // Обрабатываем одну из последовательностей: \\, \n, \t, \r, \"
-            switch (escaped_char) {
-            case 'n':
-                line.push_back('\n');
-                break;
-            case 't':
-                line.push_back('\t');
-                break;
-            case 'r':
-                line.push_back('\r');
+            const char ch = *pos_++;
+            if (ch == '"') {
+                // Встретили закрывающую кавычку
                 break;
-            case '"':
-                line.push_back('"');
-                break;
-            case '\\':
-                line.push_back('\\');
-                break;
-            default:
-                // Встретили неизвестную escape-последовательность
-                throw ParsingError("Unrecognized escape sequence \\"s + escaped_char);
+            }
+            else if (ch == '\\') {
+                // Встретили начало escape-последовательности
+                if (pos_ == end_ && !Fill(pos_)) {
+                    // Поток завершился сразу после символа обратной косой черты
+                    throw ParsingError("String parsing error");
+                }
+                const char escaped_char = *pos_++;
+                // Обрабатываем одну из последовательностей: \\, \n, \t, \r, \"
+                switch (escaped_char) {
+                case 'n':
+                    scratch_.push_back('\n');
+                    break;
+                case 't':
+                    scratch_.push_back('\t');
+                    break;
+                case 'r':
+                    scratch_.push_back('\r');
+                    break;
+                case '"':
+                    scratch_.push_back('"');
+                    break;
+                case '\\':
+                    scratch_.push_back('\\');
+                    break;
+                default:
+                    // Встретили неизвестную escape-последовательность
+                    throw ParsingError("Unrecognized escape sequence \\"s + escaped_char);
+                }
+                scratch_ += ScanPlain();
+            }
+            else {
+                // Строковый литерал внутри JSON не может прерываться символами \r или \n
+                throw ParsingError("Unexpected end of line"s);
             }
         }
-        else if (ch == '\n' || ch == '\r') {
-            // Строковый литерал внутри- JSON не может прерываться символами \r или \n
-            throw ParsingError("Unexpected end of line"s);
-        }
-        else {
-            // Просто считываем очередной символ и помещаем его в результирующую строку
-            line.push_back(ch);
-        }
-        ++it;
+
+        return scratch_;
     }
 
-    return Node(move(line));
+    void LoadNumber() {
+        using namespace std::literals;
 
-}
+        const char* start = pos_;
+        // есть ли следующий символ; начало числа при дочитывании переносится вместе с ним
+        auto has_char = [this, &start] {
+            return pos_ != end_ || Fill(start);
+        };
 
-Node LoadDict(istream& input) {
-    Dict result;
+        // Считывает одну или более цифр
+        auto read_digits = [this, &has_char] {
+            if (!has_char() || !IsDigit(*pos_)) {
+                throw ParsingError("A digit is expected"s);
+            }
+            while (has_char() && IsDigit(*pos_)) {
+                ++pos_;
+            }
+        };
 
-    for (char c; input >> c && c != '}';) {
-        if (c == ',') {
-            input >> c;
+        if (has_char() && *pos_ == '-') {
+            ++pos_;
+        }
+        // Парсим целую часть числа
+        if (has_char() && *pos_ == '0') {
+            // После 0 в JSON не могут идти другие цифры
+            ++pos_;
+        }
+        else {
+            read_digits();
         }
 
-        string key = LoadString(input).AsString();
-        input >> c;
-        result.insert({move(key), LoadNode(input)});
-    }
+        bool is_int = true;
+        // Парсим дробную часть числа
+        if (has_char() && *pos_ == '.') {
+            ++pos_;
+            read_digits();
+            is_int = false;
+        }
 
-    return Node(move(result));
-}
+        // Парсим экспоненциальную часть числа
+        if (has_char() && (*pos_ == 'e' || *pos_ == 'E')) {
+            ++pos_;
+            if (has_char() && (*pos_ == '+' || *pos_ == '-')) {
+                ++pos_;
+            }
+            read_digits();
+            is_int = false;
+        }
 
-void CheckValue(istream& input, std::string sample) {
-    std::string buffer;
-    for (char letter : sample) {
-        char next_char = input.get();
-        if (letter != next_char) {
-            for (char ch : buffer) {
-                input.putback(std::move(ch));
+        if (is_int) {
+            // Сначала пробуем преобразовать в int, при переполнении число станет double
+            int int_value = 0;
+            if (const auto [ptr, ec] = from_chars(start, pos_, int_value); ec == errc{} && ptr == pos_) {
+                handler_.Int(int_value);
+                return;
             }
-            throw ParsingError("Incorrect value"s);
         }
-        buffer += next_char;
+
+        double double_value = 0.;
+        if (const auto [ptr, ec] = from_chars(start, pos_, double_value); ec != errc{} || ptr != pos_) {
+            throw ParsingError("Failed to convert "s + string(start, pos_) + " to number"s);
+        }
+        handler_.Double(double_value);
     }
-}
 
-Node LoadNode(istream& input) {
-    char c;
-    input >> c;
-    
-    if (c == '[') {
-        if (input.peek() == ']') { 
-            input >> c; //прочитаем, чтоб последующая обработка была корректной
-            return Array{}; 
+    void CheckValue(string_view sample) {
+        while (static_cast<size_t>(end_ - pos_) < sample.size() && Fill(pos_)) {
         }
-        return LoadArray(input);
-    } else if (c == '{') {
-        if (input.peek() == '}') {
-            input >> c; //прочитаем, чтоб последующая обработка была корректной
-            return Dict{};
-        } 
-        return LoadDict(input);
-    }
-    else if (c == '"') {
-        return LoadString(input);
-    }
-    else if (c == 'n') { //null       
-        CheckValue(input, "ull"s);
-        return Node{};
-    }    
-    else if (c == 't') { //true       
-        CheckValue(input, "rue"s);
-        return Node{ true };
-    } 
-    else if (c == 'f') { //false
-        CheckValue(input, "alse"s);
-        return Node{ false };
-    }
-    else {        
-        input.putback(c);
-        return LoadInt(input);
+        if (static_cast<size_t>(end_ - pos_) < sample.size() || string_view(pos_, sample.size()) != sample) {
+            throw ParsingError("Incorrect value"s);
+        }
+        pos_ += sample.size();
     }
-}
+};
 
 }  // namespace
 
@@ -343,19 +462,191 @@ bool Document::operator!=(const Document& rhs) const
     return !(GetRoot() == rhs.GetRoot());
 }
 
+//------ NodeBuilder ------
+void NodeBuilder::Null() {
+    AddValue(Node{});
+}
+
+void NodeBuilder::Bool(bool value) {
+    AddValue(Node{ value });
+}
+
+void NodeBuilder::Int(int value) {
+    AddValue(Node{ value });
+}
+
+void NodeBuilder::Double(double value) {
+    AddValue(Node{ value });
+}
+
+void NodeBuilder::String(string_view value) {
+    AddValue(Node{ string(value) });
+}
+
+void NodeBuilder::StartArray() {
+    stack_.emplace_back(Array{});
+}
+
+void NodeBuilder::EndArray() {
+    Node value = move(stack_.back());
+    stack_.pop_back();
+    AddValue(move(value));
+}
+
+void NodeBuilder::StartDict() {
+    stack_.emplace_back(Dict{});
+}
+
+void NodeBuilder::Key(string_view key) {
+    keys_.emplace_back(key);
+}
+
+void NodeBuilder::EndDict() {
+    Node value = move(stack_.back());
+    stack_.pop_back();
+    AddValue(move(value));
+}
+
+bool NodeBuilder::IsComplete() const {
+    return root_.has_value();
+}
+
+Node NodeBuilder::Extract() {
+    Node result = move(*root_);
+    root_.reset();
+    return result;
+}
+
+void NodeBuilder::AddValue(Node value) {
+    if (stack_.empty()) {
+        root_ = move(value);
+    }
+    else if (stack_.back().IsArray()) {
+        get<Array>(stack_.back().GetValue()).push_back(move(value));
+    }
+    else {
+        // при повторе ключа остается первое значение
+        get<Dict>(stack_.back().GetValue()).emplace(move(keys_.back()), move(value));
+        keys_.pop_back();
+    }
+}
+
+//------ Parse ------
+namespace {
+
+template <typename EventHandler>
+void ParseBuffer(string_view input, EventHandler& handler) {
+    Parser<EventHandler> parser(input.data(), input.data() + input.size(), handler);
+    parser.LoadNode();
+}
+
+}  // namespace
+
+void Parse(string_view input, Handler& handler) {
+    ParseBuffer(input, handler);
+}
+
+void Parse(istream& input, Handler& handler) {
+    Parser<Handler> parser(input, handler);
+    parser.LoadNode();
+    parser.ReturnUnread();
+}
+
+Document Load(string_view input) {
+    NodeBuilder builder;
+    ParseBuffer(input, builder);
+    return Document{ builder.Extract() };
+}
+
 Document Load(istream& input) {
-    return Document{LoadNode(input)};
+    NodeBuilder builder;
+    Parser<NodeBuilder> parser(input, builder);
+    parser.LoadNode();
+    parser.ReturnUnread();
+    return Document{ builder.Extract() };
+}
+
+//------ OutputBuffer ------
+OutputBuffer::OutputBuffer(std::ostream& output)
+    : output_(output) {
+    buffer_.reserve(WRITE_THRESHOLD + WRITE_THRESHOLD / 4);
+}
+
+OutputBuffer::~OutputBuffer() {
+    output_.write(buffer_.data(), static_cast<streamsize>(buffer_.size()));
+}
+
+OutputBuffer& OutputBuffer::operator<<(string_view text) {
+    // буфер не перевыделяется: накопленное уходит в поток раньше, чем кусок перестанет помещаться,
+    // а большой кусок (например, отрисованная карта) передается в поток напрямую
+    if (buffer_.size() + text.size() > buffer_.capacity()) {
+        output_.write(buffer_.data(), static_cast<streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+    if (text.size() >= WRITE_THRESHOLD) {
+        output_.write(text.data(), static_cast<streamsize>(text.size()));
+        return *this;
+    }
+    buffer_.append(text);
+    WriteIfFull();
+    return *this;
 }
 
+OutputBuffer& OutputBuffer::operator<<(char ch) {
+    buffer_.push_back(ch);
+    WriteIfFull();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(int value) {
+    char chars[16];
+    const auto [ptr, ec] = to_chars(begin(chars), end(chars), value);
+    return *this << string_view(chars, ptr - chars);
+}
+
+OutputBuffer& OutputBuffer::operator<<(double value) {
+    // поток с настройками по умолчанию выводит double как printf("%.6g"),
+    // to_chars в формате general с точностью 6 дает тот же результат
+    char chars[32];
+    const auto [ptr, ec] = to_chars(begin(chars), end(chars), value, chars_format::general, 6);
+    return *this << string_view(chars, ptr - chars);
+}
+
+void OutputBuffer::Flush() {
+    output_.write(buffer_.data(), static_cast<streamsize>(buffer_.size()));
+    buffer_.clear();
+    output_.flush();
+}
+
+void OutputBuffer::WriteIfFull() {
+    if (buffer_.size() >= WRITE_THRESHOLD) {
+        output_.write(buffer_.data(), static_cast<streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+}
+
+//------ PrintStyle ------
+const PrintStyle PrintStyle::PRETTY{};
+const PrintStyle PrintStyle::COMPACT{ 0, false, ":"sv };
+
 //------ PrintContext ------
 void PrintContext::PrintIndent() const {
+    if (!style.new_lines) {
+        return;
+    }
     for (int i = 0; i < indent; ++i) {
-        out.put(' ');
+        out << ' ';
+    }
+}
+
+void PrintContext::PrintNewLine() const {
+    if (style.new_lines) {
+        out << '\n';
     }
 }
 
 PrintContext PrintContext::Indented() const {
-    return { out, indent_step, indent_step + indent };
+    return { out, style, style.indent_step + indent };
 }
 
 //------ перегрузка ф-й для variant -----
@@ -364,19 +655,49 @@ void PrintValue(std::nullptr_t, const PrintContext& ctx) {
 }
 
 void PrintValue(const std::string& str, const PrintContext& ctx) {
-    ctx.out << "\""sv;
+    PrintValue(string_view(str), ctx);
+}
+
+namespace {
+
+// передает append строку в кавычках с экранированием по кускам
+template <typename Append>
+void QuoteTo(string_view str, Append append) {
+    append("\""sv);
     
-    for (const char& ch : str) {
-        if (ch == '\"') { ctx.out << "\\"sv << ch; }
-        else if (ch == '\r') { ctx.out << "\\r"sv; } 
-        else if (ch == '\n') { ctx.out << "\\n"sv; }
-        else if (ch == '\\') { ctx.out << "\\"sv << ch; }
-        else {
-            ctx.out << ch;
+    // куски без экранируемых символов копируются целиком
+    const char* pos = str.data();
+    const char* const end = pos + str.size();
+    while (true) {
+        const char* special = detail::FindStringSpecial(pos, end);
+        append(string_view(pos, special - pos));
+        if (special == end) {
+            break;
         }
+
+        const char ch = *special;
+        if (ch == '\"') { append("\\\""sv); }
+        else if (ch == '\r') { append("\\r"sv); } 
+        else if (ch == '\n') { append("\\n"sv); }
+        else if (ch == '\\') { append("\\\\"sv); }
+        pos = special + 1;
     }
         
-    ctx.out << "\""sv;
+    append("\""sv);
+}
+
+}  // namespace
+
+void PrintValue(string_view str, const PrintContext& ctx) {
+    QuoteTo(str, [&ctx](string_view part) { ctx.out << part; });
+}
+
+void PrintValue(QuotedString str, const PrintContext& ctx) {
+    ctx.out << str.text;
+}
+
+void AppendQuoted(std::string& output, std::string_view str) {
+    QuoteTo(str, [&output](string_view part) { output.append(part); });
 }
 
 void PrintValue(const bool flag, const PrintContext& ctx) {
@@ -394,20 +715,17 @@ void PrintValue(const Array& arr, const PrintContext& ctx) {
     const PrintContext& ctx_context = ctx.Indented();
     
     ctx.out << "["sv;
-    if (arr.size() > 0) { ctx.out << std::endl; }
+    if (arr.size() > 0) { ctx.PrintNewLine(); }
 
     for (const auto& val : arr) {
-        if (!is_first) { ctx_context.out << ","sv << std::endl; }
+        if (!is_first) { ctx_context.out << ","sv; ctx_context.PrintNewLine(); }
         
         ctx_context.PrintIndent();
-        std::visit(
-            [&ctx_context](auto value) {
-                PrintValue(value, ctx_context);
-            }, val.GetValue());
+        PrintNode(val, ctx_context);
         if (is_first) { is_first = false; }        
     }
     
-    ctx_context.out << std::endl; 
+    ctx_context.PrintNewLine();
     ctx.PrintIndent();
     ctx_context.out << "]"sv;
 }
@@ -417,40 +735,51 @@ void PrintValue(const Dict& dict, const PrintContext& ctx) {
     bool is_first = true;
     const PrintContext& ctx_context = ctx.Indented();
         
-    ctx.out << "{"sv << std::endl;
+    ctx.out << "{"sv;
+    ctx.PrintNewLine();
 
     for (const auto& [str, node] : dict) {        
-        if (!is_first) { ctx_context.out << ","sv << std::endl; }
+        if (!is_first) { ctx_context.out << ","sv; ctx_context.PrintNewLine(); }
         ctx_context.PrintIndent();
-        ctx_context.out << "\""sv << str << "\": "sv;
+        ctx_context.out << "\""sv << str << "\""sv << ctx.style.key_separator;
         
-        std::visit(
-            [&ctx_context](auto value) {
-                PrintValue(value, ctx_context);
-            }, node.GetValue());
+        PrintNode(node, ctx_context);
         
         if (is_first) { is_first = false; }
         
     }
 
-    ctx_context.out << std::endl;
+    ctx_context.PrintNewLine();
     ctx.PrintIndent();
     ctx_context.out << "}"sv;
 
 }
 //----- конец перегрузки -----
 
-void Print(const Document& doc, std::ostream& output) {
-    
-    PrintContext ctx{ output };
-    const Node& node = doc.GetRoot();
-
+void PrintNode(const Node& node, const PrintContext& ctx) {
     std::visit(
-        [&ctx](auto value){
+        [&ctx](const auto& value) {
             PrintValue(value, ctx);
         }, node.GetValue()
     );
+}
+
+void Print(const Document& doc, std::ostream& output) {
+    Print(doc, output, PrintStyle::PRETTY);
+}
+
+void PrintCompact(const Document& doc, std::ostream& output) {
+    Print(doc, output, PrintStyle::COMPACT);
+}
+
+void Print(const Document& doc, std::ostream& output, const PrintStyle& style) {
+
+    OutputBuffer buffer(output);
+    PrintContext ctx{ buffer, style };
+
+    PrintNode(doc.GetRoot(), ctx);
 
+    buffer.Flush();
 }
 
 
@@ -2,7 +2,9 @@
 
 #include <iostream>
 #include <map>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <variant>
 
@@ -68,15 +70,113 @@ private:
     Node root_;
 };
 
+// Обработчик событий разбора. Parse вызывает его методы по мере чтения документа,
+// дерево узлов при этом не строится. Значение в словаре идет сразу после своего Key.
+// Строки String и Key указывают в буфер разборщика и действительны только до возврата из вызова
+class Handler {
+public:
+    virtual ~Handler() = default;
+
+    virtual void Null() = 0;
+    virtual void Bool(bool value) = 0;
+    virtual void Int(int value) = 0;
+    virtual void Double(double value) = 0;
+    virtual void String(std::string_view value) = 0;
+    virtual void StartArray() = 0;
+    virtual void EndArray() = 0;
+    virtual void StartDict() = 0;
+    virtual void Key(std::string_view key) = 0;
+    virtual void EndDict() = 0;
+};
+
+// Собирает узел из событий разбора.
+// Потоковый обработчик может передавать ему события части документа, чтобы получить ее в виде узла
+class NodeBuilder final : public Handler {
+public:
+    void Null() override;
+    void Bool(bool value) override;
+    void Int(int value) override;
+    void Double(double value) override;
+    void String(std::string_view value) override;
+    void StartArray() override;
+    void EndArray() override;
+    void StartDict() override;
+    void Key(std::string_view key) override;
+    void EndDict() override;
+
+    // возвращает true, когда узел собран полностью
+    bool IsComplete() const;
+    // забирает собранный узел, после чего можно собирать следующий
+    Node Extract();
+
+private:
+    std::vector<Node> stack_;        // открытые массивы и словари
+    std::vector<std::string> keys_;  // ключи открытых словарей, для которых еще нет значения
+    std::optional<Node> root_;
+
+    void AddValue(Node value);
+};
+
+// разбирает документ из буфера в памяти и передает события обработчику
+void Parse(std::string_view input, Handler& handler);
+// разбирает документ из потока, читая его блоками, и передает события по мере чтения.
+// Текст, прочитанный блоком после конца документа, возвращается в поток, и следующее чтение начинается сразу за документом
+void Parse(std::istream& input, Handler& handler);
+
+// разбирает документ из буфера в памяти
+Document Load(std::string_view input);
+// разбирает документ из потока, читая его блоками; поток, как и в Parse, остается сразу за документом
 Document Load(std::istream& input);
 
-// Контекст вывода, хранит ссылку на поток вывода и текущий отсуп
-struct PrintContext {
-    std::ostream& out;
+// Буфер вывода: накапливает текст и передает его в поток большими блоками.
+// Числа форматируются std::to_chars так же, как их выводит поток с настройками по умолчанию
+class OutputBuffer {
+public:
+    explicit OutputBuffer(std::ostream& output);
+    // передает в поток то, что еще не передано
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    OutputBuffer& operator<<(std::string_view text);
+    OutputBuffer& operator<<(char ch);
+    OutputBuffer& operator<<(int value);
+    OutputBuffer& operator<<(double value);
+
+    // передает накопленный текст в поток и сбрасывает поток
+    void Flush();
+
+private:
+    // при таком размере накопленный текст передается в поток
+    static constexpr size_t WRITE_THRESHOLD = 1 << 16;
+
+    std::ostream& output_;
+    std::string buffer_;
+
+    void WriteIfFull();
+};
+
+// Оформление вывода: шаг отступа, переводы строк и разделитель между ключом и значением
+struct PrintStyle {
     int indent_step = 4;
+    bool new_lines = true;  // при false вывод идет одной строкой без отступов
+    std::string_view key_separator = ": ";
+
+    // многострочный вывод с отступом в 4 пробела
+    static const PrintStyle PRETTY;
+    // одна строка без пробелов между элементами
+    static const PrintStyle COMPACT;
+};
+
+// Контекст вывода, хранит ссылку на буфер вывода, оформление и текущий отсуп
+struct PrintContext {
+    OutputBuffer& out;
+    const PrintStyle& style;
     int indent = 0;
 
     void PrintIndent() const;
+    void PrintNewLine() const;
 
     // Возвращает новый контекст вывода с увеличенным смещением
     PrintContext Indented() const;
@@ -91,8 +191,18 @@ void PrintValue(const Value& value, const PrintContext& ctx) {
 // Перегрузка функции PrintValue для вывода значений null
 void PrintValue(std::nullptr_t, const PrintContext& ctx);
 
+// Строка, уже заключенная в кавычки и экранированная, выводится как есть
+struct QuotedString {
+    std::string_view text;
+};
+
+// дописывает к output строку str в кавычках и с экранированием, как ее выводит PrintValue
+void AppendQuoted(std::string& output, std::string_view str);
+
 // Перегрузка функции PrintValue для вывода значений string
 void PrintValue(const std::string& str, const PrintContext & ctx);
+void PrintValue(std::string_view str, const PrintContext& ctx);
+void PrintValue(QuotedString str, const PrintContext& ctx);
 
 // Перегрузка функции PrintValue для вывода значений bool
 void PrintValue(const bool flag, const PrintContext& ctx);
@@ -103,6 +213,12 @@ void PrintValue(const Array& arr, const PrintContext& ctx);
 // Перегрузка функции PrintValue для вывода значений map
 void PrintValue(const Dict& dict, const PrintContext& ctx);
 
+// выводит значение узла, обходя вложенные массивы и словари по ссылке без копирования
+void PrintNode(const Node& node, const PrintContext& ctx);
+
 void Print(const Document& doc, std::ostream& output);
+// выводит документ одной строкой без пробелов между элементами
+void PrintCompact(const Document& doc, std::ostream& output);
+void Print(const Document& doc, std::ostream& output, const PrintStyle& style);
 
 }  // namespace json
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include "json_arena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+using namespace std;
+
+namespace json {
+
+//------ ArenaArray ------
+ArenaArray::ArenaArray(const ArenaNode* data, size_t size)
+    : data_(data)
+    , size_(size) {
+}
+
+const ArenaNode* ArenaArray::begin() const {
+    return data_;
+}
+
+const ArenaNode* ArenaArray::end() const {
+    return data_ + size_;
+}
+
+size_t ArenaArray::size() const {
+    return size_;
+}
+
+bool ArenaArray::empty() const {
+    return size_ == 0;
+}
+
+const ArenaNode& ArenaArray::operator[](size_t index) const {
+    return data_[index];
+}
+
+//------ ArenaDict ------
+ArenaDict::ArenaDict(const ArenaMember* data, size_t size)
+    : data_(data)
+    , size_(size) {
+}
+
+const ArenaMember* ArenaDict::begin() const {
+    return data_;
+}
+
+const ArenaMember* ArenaDict::end() const {
+    return data_ + size_;
+}
+
+size_t ArenaDict::size() const {
+    return size_;
+}
+
+bool ArenaDict::empty() const {
+    return size_ == 0;
+}
+
+const ArenaMember* ArenaDict::find(string_view key) const {
+    const ArenaMember* it = lower_bound(begin(), end(), key,
+        [](const ArenaMember& member, string_view key) {
+            return member.first < key;
+        });
+    if (it != end() && it->first == key) {
+        return it;
+    }
+    return end();
+}
+
+size_t ArenaDict::count(string_view key) const {
+    return find(key) != end() ? 1 : 0;
+}
+
+const ArenaNode& ArenaDict::at(string_view key) const {
+    const ArenaMember* it = find(key);
+    if (it == end()) {
+        throw out_of_range("No such key in dict"s);
+    }
+    return it->second;
+}
+
+//------ ArenaNode ------
+const ArenaNode::Value& ArenaNode::GetValue() const { return *this; }
+
+bool ArenaNode::IsInt() const {
+    return holds_alternative<int>(*this);
+}
+
+int ArenaNode::AsInt() const {
+    if (!IsInt()) {
+        throw logic_error("Contains a value of another type"s);
+    }
+    return get<int>(*this);
+}
+
+bool ArenaNode::IsDouble() const {
+    return IsInt() || IsPureDouble();
+}
+
+bool ArenaNode::IsPureDouble() const {
+    return holds_alternative<double>(*this);
+}
+
+double ArenaNode::AsDouble() const {
+    if (!IsDouble()) {
+        throw logic_error("Not a double"s);
+    }
+    return IsPureDouble() ? get<double>(*this) : AsInt();
+}
+
+bool ArenaNode::IsBool() const {
+    return holds_alternative<bool>(*this);
+}
+
+bool ArenaNode::AsBool() const {
+    if (!IsBool()) {
+        throw logic_error("Not a bool"s);
+    }
+    return get<bool>(*this);
+}
+
+bool ArenaNode::IsString() const {
+    return holds_alternative<string_view>(*this);
+}
+
+string_view ArenaNode::AsString() const {
+    if (!IsString()) {
+        throw logic_error("Not a string"s);
+    }
+    return get<string_view>(*this);
+}
+
+bool ArenaNode::IsNull() const {
+    return holds_alternative<nullptr_t>(*this);
+}
+
+bool ArenaNode::IsArray() const {
+    return holds_alternative<ArenaArray>(*this);
+}
+
+const ArenaArray& ArenaNode::AsArray() const {
+    if (!IsArray()) {
+        throw logic_error("Not an array"s);
+    }
+    return get<ArenaArray>(*this);
+}
+
+bool ArenaNode::IsDict() const {
+    return holds_alternative<ArenaDict>(*this);
+}
+
+const ArenaDict& ArenaNode::AsDict() const {
+    if (!IsDict()) {
+        throw logic_error("Not a dict"s);
+    }
+    return get<ArenaDict>(*this);
+}
+
+//------ ArenaDocument ------
+ArenaDocument::ArenaDocument(size_t initial_size)
+    : initial_buffer_(make_unique<byte[]>(initial_size))
+    , arena_(initial_buffer_.get(), initial_size)
+    , keys_(in_place, &arena_) {
+}
+
+void ArenaDocument::Clear() {
+    // таблица ключей лежит в арене, поэтому уничтожается раньше, чем освобождается арена
+    keys_.reset();
+    // арена возвращается к начальному буферу, дополнительные блоки освобождаются
+    arena_.release();
+    keys_.emplace(&arena_);
+}
+
+string_view ArenaDocument::AddString(string_view str) {
+    if (str.empty()) {
+        return {};
+    }
+    char* data = static_cast<char*>(arena_.allocate(str.size(), alignof(char)));
+    memcpy(data, str.data(), str.size());
+    return { data, str.size() };
+}
+
+string_view ArenaDocument::InternKey(string_view key) {
+    if (const auto it = keys_->find(key); it != keys_->end()) {
+        return *it;
+    }
+    return *keys_->insert(AddString(key)).first;
+}
+
+// узлы не владеют памятью и не требуют деструкторов, поэтому их можно просто забыть при Clear
+ArenaNode* ArenaDocument::AllocateNodes(size_t count) {
+    return static_cast<ArenaNode*>(arena_.allocate(count * sizeof(ArenaNode), alignof(ArenaNode)));
+}
+
+ArenaMember* ArenaDocument::AllocateMembers(size_t count) {
+    return static_cast<ArenaMember*>(arena_.allocate(count * sizeof(ArenaMember), alignof(ArenaMember)));
+}
+
+//------ ArenaBuilder ------
+namespace {
+
+// Устойчивая сортировка пар по ключу. В запросах словари небольшие, и сортировка вставками
+// обходится без временного буфера, который выделяет std::stable_sort
+void SortMembers(ArenaMember* begin, ArenaMember* end) {
+    constexpr ptrdiff_t INSERTION_SORT_LIMIT = 32;
+    const auto key_less = [](const ArenaMember& lhs, const ArenaMember& rhs) {
+        return lhs.first < rhs.first;
+    };
+
+    if (end - begin > INSERTION_SORT_LIMIT) {
+        stable_sort(begin, end, key_less);
+        return;
+    }
+
+    for (ArenaMember* it = begin + (begin != end); it < end; ++it) {
+        ArenaMember member = *it;
+        ArenaMember* pos = it;
+        for (; pos != begin && key_less(member, *(pos - 1)); --pos) {
+            *pos = *(pos - 1);
+        }
+        *pos = member;
+    }
+}
+
+}  // namespace
+
+ArenaBuilder::ArenaBuilder(ArenaDocument& document)
+    : document_(document) {
+}
+
+void ArenaBuilder::Null() {
+    AddValue(ArenaNode{});
+}
+
+void ArenaBuilder::Bool(bool value) {
+    AddValue(ArenaNode{ value });
+}
+
+void ArenaBuilder::Int(int value) {
+    AddValue(ArenaNode{ value });
+}
+
+void ArenaBuilder::Double(double value) {
+    AddValue(ArenaNode{ value });
+}
+
+void ArenaBuilder::String(string_view value) {
+    AddValue(ArenaNode{ document_.AddString(value) });
+}
+
+void ArenaBuilder::StartArray() {
+    frames_.push_back({ values_.size(), keys_.size() });
+}
+
+void ArenaBuilder::EndArray() {
+    const Frame frame = frames_.back();
+    frames_.pop_back();
+
+    // элементы массива переносятся в арену одним блоком
+    const size_t size = values_.size() - frame.first_value;
+    ArenaNode* data = document_.AllocateNodes(size);
+    uninitialized_copy(values_.begin() + frame.first_value, values_.end(), data);
+    values_.resize(frame.first_value);
+
+    AddValue(ArenaNode{ ArenaArray(data, size) });
+}
+
+void ArenaBuilder::StartDict() {
+    frames_.push_back({ values_.size(), keys_.size() });
+}
+
+void ArenaBuilder::Key(string_view key) {
+    keys_.push_back(document_.InternKey(key));
+}
+
+void ArenaBuilder::EndDict() {
+    const Frame frame = frames_.back();
+    frames_.pop_back();
+
+    const size_t size = values_.size() - frame.first_value;
+    ArenaMember* data = document_.AllocateMembers(size);
+    for (size_t i = 0; i < size; ++i) {
+        new (data + i) ArenaMember(keys_[frame.first_key + i], values_[frame.first_value + i]);
+    }
+    values_.resize(frame.first_value);
+    keys_.resize(frame.first_key);
+
+    // пары сортируются по ключу, при повторе ключа остается первое значение, как в Dict
+    SortMembers(data, data + size);
+    const ArenaMember* unique_end = unique(data, data + size,
+        [](const ArenaMember& lhs, const ArenaMember& rhs) {
+            return lhs.first == rhs.first;
+        });
+
+    AddValue(ArenaNode{ ArenaDict(data, static_cast<size_t>(unique_end - data)) });
+}
+
+bool ArenaBuilder::IsComplete() const {
+    return root_.has_value();
+}
+
+ArenaNode ArenaBuilder::Extract() {
+    ArenaNode result = *root_;
+    root_.reset();
+    return result;
+}
+
+void ArenaBuilder::AddValue(ArenaNode value) {
+    if (frames_.empty()) {
+        root_ = value;
+    }
+    else {
+        values_.push_back(value);
+    }
+}
+
+}  // namespace json
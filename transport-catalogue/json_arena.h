@@ -0,0 +1,162 @@
+#pragma once
+
+#include "json.h"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace json {
+
+// Узлы и строки документа размещаются в арене ArenaDocument, а не выделяются по отдельности.
+// Массивы и словари хранятся непрерывными блоками, словарь - отсортированными по ключу парами,
+// ключи словарей хранятся в документе по одному разу. Узлы только ссылаются на память арены
+// и остаются действительными до Clear документа
+
+class ArenaNode;
+using ArenaMember = std::pair<std::string_view, ArenaNode>;
+
+// Массив узлов в арене
+class ArenaArray {
+public:
+    ArenaArray() = default;
+    ArenaArray(const ArenaNode* data, size_t size);
+
+    const ArenaNode* begin() const;
+    const ArenaNode* end() const;
+    size_t size() const;
+    bool empty() const;
+
+    const ArenaNode& operator[](size_t index) const;
+
+private:
+    const ArenaNode* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Словарь в арене. Поиск ключа двоичный, при повторе ключа во входных данных остается первое значение,
+// как в Dict
+class ArenaDict {
+public:
+    ArenaDict() = default;
+    ArenaDict(const ArenaMember* data, size_t size);
+
+    const ArenaMember* begin() const;
+    const ArenaMember* end() const;
+    size_t size() const;
+    bool empty() const;
+
+    // возвращает end(), если ключа нет
+    const ArenaMember* find(std::string_view key) const;
+    size_t count(std::string_view key) const;
+    // выбрасывает std::out_of_range, если ключа нет
+    const ArenaNode& at(std::string_view key) const;
+
+private:
+    const ArenaMember* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Узел документа в арене. Методы доступа повторяют методы Node, строки возвращаются как std::string_view
+class ArenaNode final : private std::variant<std::nullptr_t, ArenaArray, ArenaDict, bool, int, double, std::string_view> {
+public:
+    using variant::variant;
+    using Value = variant;
+
+    const Value& GetValue() const;
+
+    bool IsInt() const;
+    int AsInt() const;
+
+    bool IsDouble() const;
+    bool IsPureDouble() const;
+    double AsDouble() const;
+
+    bool IsBool() const;
+    bool AsBool() const;
+
+    bool IsString() const;
+    std::string_view AsString() const;
+
+    bool IsNull() const;
+
+    bool IsArray() const;
+    const ArenaArray& AsArray() const;
+
+    bool IsDict() const;
+    const ArenaDict& AsDict() const;
+};
+
+class ArenaDocument {
+public:
+    // первые initial_size байт арены выделяются один раз и переиспользуются после Clear
+    explicit ArenaDocument(size_t initial_size = 16 * 1024);
+
+    ArenaDocument(const ArenaDocument&) = delete;
+    ArenaDocument& operator=(const ArenaDocument&) = delete;
+
+    // освобождает узлы, строки и ключи документа
+    void Clear();
+
+    // копирует строку в арену
+    std::string_view AddString(std::string_view str);
+    // возвращает ключ, сохраненный в документе, одинаковые ключи документа хранятся один раз
+    std::string_view InternKey(std::string_view key);
+    // выделяет в арене место под count узлов или пар словаря
+    ArenaNode* AllocateNodes(size_t count);
+    ArenaMember* AllocateMembers(size_t count);
+
+private:
+    std::unique_ptr<std::byte[]> initial_buffer_;
+    std::pmr::monotonic_buffer_resource arena_;
+    // Таблица ключей документа. Ключи зависят от данных (например, имена остановок в road_distances),
+    // поэтому таблица вместе с ключами размещается в arena_ и пересоздается при Clear
+    std::optional<std::pmr::unordered_set<std::string_view>> keys_;
+};
+
+// Собирает документ в арене из событий разбора, как NodeBuilder собирает Node.
+// Промежуточные стеки сборщика переиспользуются между документами
+class ArenaBuilder final : public Handler {
+public:
+    explicit ArenaBuilder(ArenaDocument& document);
+
+    void Null() override;
+    void Bool(bool value) override;
+    void Int(int value) override;
+    void Double(double value) override;
+    void String(std::string_view value) override;
+    void StartArray() override;
+    void EndArray() override;
+    void StartDict() override;
+    void Key(std::string_view key) override;
+    void EndDict() override;
+
+    // возвращает true, когда узел собран полностью
+    bool IsComplete() const;
+    // забирает собранный узел, он живет до Clear документа
+    ArenaNode Extract();
+
+private:
+    // открытый массив или словарь
+    struct Frame {
+        size_t first_value = 0;  // начало элементов в values_
+        size_t first_key = 0;    // начало ключей в keys_
+    };
+
+    ArenaDocument& document_;
+    std::vector<Frame> frames_;
+    std::vector<ArenaNode> values_;       // элементы открытых массивов и словарей
+    std::vector<std::string_view> keys_;  // ключи открытых словарей
+    std::optional<ArenaNode> root_;
+
+    void AddValue(ArenaNode value);
+};
+
+}  // namespace json
@@ -0,0 +1,163 @@
+// Замер вывода JSON: печатает большой вложенный документ и строку размером с отрисованную карту
+// и считает выделения памяти во время печати. Глобальный operator new заменен счетчиком,
+// печать через PrintNode не должна выделять память ни на один узел
+#include "json.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace {
+
+    std::atomic<size_t> allocation_count{ 0 };
+
+    // поток, который только считает выведенные символы
+    class CountingBuffer : public std::streambuf {
+    public:
+        size_t GetSize() const { return size_; }
+
+    protected:
+        int_type overflow(int_type ch) override {
+            ++size_;
+            return traits_type::not_eof(ch);
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize count) override {
+            size_ += static_cast<size_t>(count);
+            return count;
+        }
+
+    private:
+        size_t size_ = 0;
+    };
+
+    // массив ответов, похожих на ответы Bus и Route
+    json::Node MakeAnswers(int count) {
+        json::Array answers;
+        answers.reserve(count);
+        for (int id = 0; id < count; ++id) {
+            json::Array items;
+            for (int i = 0; i < 4; ++i) {
+                items.emplace_back(json::Dict{
+                    { "span_count", i + 1 },
+                    { "bus", "Автобус \"" + std::to_string(id % 97) + "\"" },
+                    { "time", 1.25 * i + id },
+                    { "type", std::string("Bus") },
+                });
+            }
+            answers.emplace_back(json::Dict{
+                { "curvature", 1.0 + id / 1e6 },
+                { "items", std::move(items) },
+                { "request_id", id },
+                { "route_length", id * 10 },
+                { "stop_count", id % 50 },
+                { "unique_stop_count", id % 25 },
+            });
+        }
+        return answers;
+    }
+
+    // ответ Map со строкой SVG заданного размера
+    json::Node MakeMapAnswer(size_t size) {
+        const std::string_view tag = "  <polyline points=\"12.5,40.75 80.125,17\" fill=\"none\" stroke=\"green\"/>\n";
+        std::string svg;
+        svg.reserve(size + tag.size());
+        while (svg.size() < size) {
+            svg.append(tag);
+        }
+        return json::Dict{ { "map", std::move(svg) }, { "request_id", 1 } };
+    }
+
+    size_t CountNodes(const json::Node& node) {
+        size_t count = 1;
+        if (node.IsArray()) {
+            for (const json::Node& item : node.AsArray()) {
+                count += CountNodes(item);
+            }
+        }
+        else if (node.IsDict()) {
+            for (const auto& [key, item] : node.AsDict()) {
+                count += CountNodes(item);
+            }
+        }
+        return count;
+    }
+
+    // печатает узел и возвращает число выделений памяти за время печати
+    size_t Measure(std::string_view name, std::string_view style_name, const json::Node& root, const json::PrintStyle& style) {
+        CountingBuffer counter;
+        std::ostream output(&counter);
+        json::OutputBuffer buffer(output);
+        const json::PrintContext ctx{ buffer, style };
+
+        const size_t allocations_before = allocation_count;
+        const auto start = std::chrono::steady_clock::now();
+        json::PrintNode(root, ctx);
+        buffer.Flush();
+        const auto finish = std::chrono::steady_clock::now();
+        const size_t allocations = allocation_count - allocations_before;
+
+        std::cout << name << ' ' << style_name
+            << ": nodes " << CountNodes(root)
+            << ", bytes " << counter.GetSize()
+            << ", allocations " << allocations
+            << ", " << std::chrono::duration<double, std::milli>(finish - start).count() << " ms\n";
+        return allocations;
+    }
+
+}   // namespace
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+int main(int argc, char* argv[]) {
+    // число ответов в документе и размер карты в байтах
+    const int answer_count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const size_t map_size = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : size_t{ 8 } << 20;
+
+    const json::Node answers = MakeAnswers(answer_count);
+    const json::Node map = MakeMapAnswer(map_size);
+
+    size_t allocations = 0;
+    allocations += Measure("answers", "pretty", answers, json::PrintStyle::PRETTY);
+    allocations += Measure("answers", "compact", answers, json::PrintStyle::COMPACT);
+    allocations += Measure("map", "pretty", map, json::PrintStyle::PRETTY);
+    allocations += Measure("map", "compact", map, json::PrintStyle::COMPACT);
+
+    if (allocations != 0) {
+        std::cout << "FAIL: printing allocated memory " << allocations << " times\n";
+        return 1;
+    }
+    std::cout << "OK: no allocations while printing\n";
+    return 0;
+}
@@ -1,54 +1,256 @@
 #include "json_reader.h"
 
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
 namespace transport_catalog {
-    
 
-    Requests JSONReader::Read(std::istream& input) {
-        
-        Requests requests;
-        json::Document doc = json::Load(input);
+    namespace {
+
+        // Пропускает значение, не собирая его: только следит за вложенностью, чтобы найти его конец
+        class SkipHandler final : public json::Handler {
+        public:
+            void Reset() {
+                depth_ = 0;
+                is_started_ = false;
+            }
+
+            bool IsComplete() const {
+                return is_started_ && depth_ == 0;
+            }
+
+            void Null() override { is_started_ = true; }
+            void Bool(bool) override { is_started_ = true; }
+            void Int(int) override { is_started_ = true; }
+            void Double(double) override { is_started_ = true; }
+            void String(std::string_view) override { is_started_ = true; }
+            void StartArray() override { Open(); }
+            void EndArray() override { --depth_; }
+            void StartDict() override { Open(); }
+            void Key(std::string_view) override {}
+            void EndDict() override { --depth_; }
+
+        private:
+            size_t depth_ = 0;
+            bool is_started_ = false;
 
-        const json::Node& node = doc.GetRoot();
+            void Open() {
+                is_started_ = true;
+                ++depth_;
+            }
+        };
 
-        if (!node.IsDict()) { throw std::invalid_argument("Wrong into file structure"); }
+        // Разбирает события корневого словаря. Элементы base_requests и stat_requests
+        // и словари настроек собираются в узлы по одному и сразу передаются получателю.
+        // Запросы base_requests собираются в арене, которая очищается после каждого запроса.
+        // Как и при загрузке в Dict, из повторяющихся ключей корневого словаря учитывается первый,
+        // значения остальных и неизвестных ключей пропускаются без сборки
+        class RequestsHandler final : public json::Handler {
+        public:
+            explicit RequestsHandler(RequestsConsumer& consumer)
+                : consumer_(consumer)
+                , base_builder_(base_document_) {
+            }
 
-        for (const auto& [key, val] : node.AsDict()) {
+            void Null() override {
+                Forward([](json::Handler& handler) { handler.Null(); });
+            }
 
-            if (val.IsArray()) {
+            void Bool(bool value) override {
+                Forward([value](json::Handler& handler) { handler.Bool(value); });
+            }
 
-                const json::Array& arr_nodes = val.AsArray();
+            void Int(int value) override {
+                Forward([value](json::Handler& handler) { handler.Int(value); });
+            }
+
+            void Double(double value) override {
+                Forward([value](json::Handler& handler) { handler.Double(value); });
+            }
 
-                //массив с описанием автобусных маршрутов и остановок
-                if (key == "base_requests") {                    
-                    requests.base_requests = arr_nodes;
+            void String(std::string_view value) override {
+                Forward([value](json::Handler& handler) { handler.String(value); });
+            }
+
+            void StartArray() override {
+                // массивы запросов не собираются целиком, собираются только их элементы
+                if (!is_building_ && depth_ == 1 && !is_repeated_key_ && (key_ == "base_requests" || key_ == "stat_requests")) {
+                    requests_target_ = key_ == "base_requests" ? Target::BASE_REQUEST : Target::STAT_REQUEST;
+                    depth_ = 2;
+                    return;
                 }
-                //массив с запросами к транспортному справочнику
-                else if (key == "stat_requests") {                  
-                    requests.stat_requests = arr_nodes;
+                Forward([](json::Handler& handler) { handler.StartArray(); });
+            }
+
+            void EndArray() override {
+                if (!is_building_) {
+                    // закончился массив запросов
+                    depth_ = 1;
+                    return;
                 }
+                Forward([](json::Handler& handler) { handler.EndArray(); });
             }
-            else if (val.IsDict()) {
 
-                const json::Dict& dict_node = val.AsDict();
-                // словарь настроек визуализации карты
-                if (key == "render_settings") {                    
-                    requests.render_settings = dict_node;
+            void StartDict() override {
+                if (!is_building_ && depth_ == 0) {
+                    depth_ = 1;
+                    return;
                 }
-                // словарь настроек маршрутизации
-                else if (key == "routing_settings") {
-                    requests.routing_settings = dict_node;
+                Forward([](json::Handler& handler) { handler.StartDict(); });
+            }
+
+            void Key(std::string_view key) override {
+                if (!is_building_) {
+                    // память ключа переиспользуется, копии остаются только у немногих ключей корневого словаря
+                    key_.assign(key);
+                    is_repeated_key_ = !seen_keys_.insert(key_).second;
+                    return;
                 }
-                // словарь настроек сериализации
-                else if (key == "serialization_settings") {
-                    requests.serialization_settings = dict_node;
+                GetBuilder().Key(key);
+            }
+
+            void EndDict() override {
+                if (!is_building_) {
+                    // закончился корневой словарь
+                    depth_ = 0;
+                    return;
+                }
+                Forward([](json::Handler& handler) { handler.EndDict(); });
+            }
+
+        private:
+            // кому достанется собираемый узел
+            enum class Target {
+                SKIP,
+                BASE_REQUEST,
+                STAT_REQUEST,
+                RENDER_SETTINGS,
+                ROUTING_SETTINGS,
+                SERIALIZATION_SETTINGS
+            };
+
+            RequestsConsumer& consumer_;
+            json::NodeBuilder builder_;
+            json::ArenaDocument base_document_;
+            json::ArenaBuilder base_builder_;
+            SkipHandler skipper_;
+            size_t depth_ = 0;           // 0 - вне документа, 1 - в корневом словаре, 2 - в массиве запросов
+            std::string key_;            // текущий ключ корневого словаря
+            std::unordered_set<std::string> seen_keys_; // уже встреченные ключи корневого словаря
+            bool is_repeated_key_ = false; // текущий ключ уже встречался, его значение пропускается
+            bool is_building_ = false;   // события передаются builder_
+            Target target_ = Target::SKIP;
+            Target requests_target_ = Target::SKIP;
+
+            // передает событие сборщику узла, начиная новый узел, если нужно
+            template <typename Event>
+            void Forward(Event event) {
+                if (!is_building_) {
+                    BeginValue();
                 }
+                event(GetBuilder());
 
+                if (target_ == Target::BASE_REQUEST) {
+                    if (base_builder_.IsComplete()) {
+                        is_building_ = false;
+                        DispatchBaseRequest(base_builder_.Extract());
+                    }
+                }
+                else if (target_ == Target::SKIP) {
+                    is_building_ = !skipper_.IsComplete();
+                }
+                else if (builder_.IsComplete()) {
+                    is_building_ = false;
+                    Dispatch(builder_.Extract());
+                }
+            }
+
+            json::Handler& GetBuilder() {
+                if (target_ == Target::BASE_REQUEST) {
+                    return base_builder_;
+                }
+                if (target_ == Target::SKIP) {
+                    return skipper_;
+                }
+                return builder_;
+            }
+
+            void DispatchBaseRequest(const json::ArenaNode& node) {
+                // запрос обязан быть словарем
+                if (!node.IsDict()) {
+                    throw std::invalid_argument("Wrong into file structure");
+                }
+                consumer_.OnBaseRequest(node.AsDict());
+                // память запроса переиспользуется следующим запросом
+                base_document_.Clear();
+            }
+
+            void BeginValue() {
+                // корень документа должен быть словарем
+                if (depth_ == 0) { throw std::invalid_argument("Wrong into file structure"); }
+
+                if (depth_ == 2) {
+                    target_ = requests_target_;
+                }
+                else if (is_repeated_key_) {
+                    target_ = Target::SKIP;
+                }
+                else if (key_ == "render_settings") {
+                    target_ = Target::RENDER_SETTINGS;
+                }
+                else if (key_ == "routing_settings") {
+                    target_ = Target::ROUTING_SETTINGS;
+                }
+                else if (key_ == "serialization_settings") {
+                    target_ = Target::SERIALIZATION_SETTINGS;
+                }
+                else {
+                    target_ = Target::SKIP;
+                }
+                if (target_ == Target::SKIP) {
+                    skipper_.Reset();
+                }
+                is_building_ = true;
             }
 
-        }
-        
-        return requests;
+            void Dispatch(json::Node node) {
+                if (!node.IsDict()) {
+                    // запрос обязан быть словарем, настройки другого вида пропускаются
+                    if (target_ == Target::BASE_REQUEST || target_ == Target::STAT_REQUEST) {
+                        throw std::invalid_argument("Wrong into file structure");
+                    }
+                    return;
+                }
+
+                json::Dict dict = std::move(std::get<json::Dict>(node.GetValue()));
+                switch (target_) {
+                case Target::STAT_REQUEST:
+                    consumer_.OnStatRequest(std::move(dict));
+                    break;
+                case Target::RENDER_SETTINGS:
+                    consumer_.OnRenderSettings(std::move(dict));
+                    break;
+                case Target::ROUTING_SETTINGS:
+                    consumer_.OnRoutingSettings(std::move(dict));
+                    break;
+                case Target::SERIALIZATION_SETTINGS:
+                    consumer_.OnSerializationSettings(std::move(dict));
+                    break;
+                case Target::BASE_REQUEST:
+                case Target::SKIP:
+                    break;
+                }
+            }
+        };
+
+    }   // namespace
+
+    void JSONReader::Read(std::istream& input, RequestsConsumer& consumer) {
+        RequestsHandler handler(consumer);
+        json::Parse(input, handler);
     }
 
 
-}	// namespace transport_catalog
\ No newline at end of file
+}	// namespace transport_catalog
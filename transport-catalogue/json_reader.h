@@ -1,28 +1,37 @@
 #pragma once
 
-#include <sstream>
+#include <istream>
 
 #include "json.h"
-#include "request_handler.h"
-#include "transport_catalogue.h"
-#include "map_renderer.h"
+#include "json_arena.h"
 
 
 namespace transport_catalog {
 
-	struct Requests {
-		json::Array base_requests; // запросы на добавление в транспортный каталог
-		json::Array stat_requests; // запросы получения информации из транспортного каталога
-		json::Dict render_settings;  // настройки карты
-		json::Dict routing_settings; // настройки маршрутизации (время ожидания автобуса и скорость автобуса)
-		json::Dict serialization_settings; // настройки сериализации
+	// Получатель запросов, которые JSONReader передает по мере чтения входного документа.
+	// Каждый запрос и каждый словарь настроек передается сразу после того, как прочитан целиком
+	class RequestsConsumer {
+	public:
+		virtual ~RequestsConsumer() = default;
+
+		// запрос на добавление в транспортный каталог (элемент base_requests).
+		// Запрос собирается в арене читателя и действителен только до возврата из метода
+		virtual void OnBaseRequest(const json::ArenaDict& request) = 0;
+		// запрос получения информации из транспортного каталога (элемент stat_requests)
+		virtual void OnStatRequest(json::Dict request) = 0;
+		// настройки карты
+		virtual void OnRenderSettings(json::Dict settings) = 0;
+		// настройки маршрутизации (время ожидания автобуса и скорость автобуса)
+		virtual void OnRoutingSettings(json::Dict settings) = 0;
+		// настройки сериализации
+		virtual void OnSerializationSettings(json::Dict settings) = 0;
 	};
 
 	class JSONReader {
 	public:		
-		// читаем поток и раскладываем запросы
-		Requests Read(std::istream& input);
+		// читаем поток и передаем запросы получателю по одному, не собирая весь документ
+		void Read(std::istream& input, RequestsConsumer& consumer);
 			
 	};
 
-}	// namespace transport_catalog
\ No newline at end of file
+}	// namespace transport_catalog
@@ -0,0 +1,188 @@
+#include "json_scan.h"
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSON_SCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(JSON_SCAN_SSE2) && (defined(__GNUC__) || defined(__clang__))
+// AVX2 включается для отдельных функций атрибутом target, вся программа собирается без него
+#define JSON_SCAN_AVX2
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace json {
+
+namespace detail {
+
+namespace {
+
+bool IsStringSpecial(char c) {
+    return c == '"' || c == '\\' || c == '\n' || c == '\r';
+}
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+const char* FindStringSpecialScalar(const char* pos, const char* end) {
+    while (pos != end && !IsStringSpecial(*pos)) {
+        ++pos;
+    }
+    return pos;
+}
+
+const char* SkipSpacesScalar(const char* pos, const char* end) {
+    while (pos != end && IsSpace(*pos)) {
+        ++pos;
+    }
+    return pos;
+}
+
+#ifdef JSON_SCAN_SSE2
+
+// номер младшего установленного бита, mask != 0
+unsigned CountTrailingZeros(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+const char* FindStringSpecialSse2(const char* pos, const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i line_feed = _mm_set1_epi8('\n');
+    const __m128i carriage_return = _mm_set1_epi8('\r');
+
+    for (; end - pos >= 16; pos += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        const __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, line_feed), _mm_cmpeq_epi8(chunk, carriage_return)));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+        if (mask != 0) {
+            return pos + CountTrailingZeros(mask);
+        }
+    }
+
+    return FindStringSpecialScalar(pos, end);
+}
+
+// блоками пропускаются пробелы, переводы строк и табуляции, редкие \v и \f дочитываются побайтово
+const char* SkipSpacesSse2(const char* pos, const char* end) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i line_feed = _mm_set1_epi8('\n');
+    const __m128i carriage_return = _mm_set1_epi8('\r');
+    const __m128i tab = _mm_set1_epi8('\t');
+
+    for (; end - pos >= 16; pos += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        const __m128i spaces = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, line_feed)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, carriage_return), _mm_cmpeq_epi8(chunk, tab)));
+        const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(spaces)) & 0xFFFFu;
+        if (mask != 0) {
+            return SkipSpacesScalar(pos + CountTrailingZeros(mask), end);
+        }
+    }
+
+    return SkipSpacesScalar(pos, end);
+}
+
+#endif  // JSON_SCAN_SSE2
+
+#ifdef JSON_SCAN_AVX2
+
+__attribute__((target("avx2")))
+const char* FindStringSpecialAvx2(const char* pos, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i line_feed = _mm256_set1_epi8('\n');
+    const __m256i carriage_return = _mm256_set1_epi8('\r');
+
+    for (; end - pos >= 32; pos += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+        const __m256i special = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, line_feed), _mm256_cmpeq_epi8(chunk, carriage_return)));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+        if (mask != 0) {
+            return pos + CountTrailingZeros(mask);
+        }
+    }
+
+    return FindStringSpecialSse2(pos, end);
+}
+
+__attribute__((target("avx2")))
+const char* SkipSpacesAvx2(const char* pos, const char* end) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i line_feed = _mm256_set1_epi8('\n');
+    const __m256i carriage_return = _mm256_set1_epi8('\r');
+    const __m256i tab = _mm256_set1_epi8('\t');
+
+    for (; end - pos >= 32; pos += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+        const __m256i spaces = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, line_feed)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, carriage_return), _mm256_cmpeq_epi8(chunk, tab)));
+        const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(spaces));
+        if (mask != 0) {
+            return SkipSpacesScalar(pos + CountTrailingZeros(mask), end);
+        }
+    }
+
+    return SkipSpacesSse2(pos, end);
+}
+
+#endif  // JSON_SCAN_AVX2
+
+using ScanFunction = const char* (*)(const char*, const char*);
+
+struct ScanFunctions {
+    ScanFunction find_string_special;
+    ScanFunction skip_spaces;
+};
+
+ScanFunctions ChooseScanFunctions() {
+#ifdef JSON_SCAN_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return { FindStringSpecialAvx2, SkipSpacesAvx2 };
+    }
+#endif
+#ifdef JSON_SCAN_SSE2
+    return { FindStringSpecialSse2, SkipSpacesSse2 };
+#else
+    return { FindStringSpecialScalar, SkipSpacesScalar };
+#endif
+}
+
+// реализация выбирается при первом обращении
+const ScanFunctions& GetScanFunctions() {
+    static const ScanFunctions functions = ChooseScanFunctions();
+    return functions;
+}
+
+}  // namespace
+
+const char* FindStringSpecial(const char* pos, const char* end) {
+    return GetScanFunctions().find_string_special(pos, end);
+}
+
+const char* SkipSpaces(const char* pos, const char* end) {
+    return GetScanFunctions().skip_spaces(pos, end);
+}
+
+}  // namespace detail
+
+}  // namespace json
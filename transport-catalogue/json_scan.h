@@ -0,0 +1,19 @@
+#pragma once
+
+namespace json {
+
+namespace detail {
+
+// Поиск символов, на которых останавливается разбор JSON.
+// Буфер просматривается блоками по 16 (SSE2) или 32 (AVX2) байта,
+// реализация выбирается один раз по возможностям процессора, без них работает побайтовый поиск
+
+// возвращает указатель на первый из символов ", \, \n, \r или end, если их нет
+const char* FindStringSpecial(const char* pos, const char* end);
+
+// возвращает указатель на первый непробельный символ или end
+const char* SkipSpaces(const char* pos, const char* end);
+
+}  // namespace detail
+
+}  // namespace json
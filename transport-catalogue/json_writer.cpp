@@ -0,0 +1,228 @@
+#include "json_writer.h"
+
+#include <stdexcept>
+
+namespace json {
+
+    using namespace std::literals;
+
+    Writer::Writer(OutputBuffer& output, const PrintStyle& style)
+        : output_(output)
+        , style_(style)
+    {}
+
+    Writer::DictItemContext Writer::StartDict()
+    {
+        BeforeValue("StartDict");
+
+        output_ << '{';
+        stack_.emplace_back(true);
+        // словарь выводится как в PrintValue: перевод строки сразу после скобки
+        GetContext(stack_.size()).PrintNewLine();
+
+        return BaseContext{ *this }; //DictItemContext (*this);
+    }
+
+    Writer& Writer::EndDict()
+    {
+        return EndContainer(true, '}', "EndDict");
+    }
+
+    Writer::ArrayItemContext Writer::StartArray()
+    {
+        BeforeValue("StartArray");
+
+        output_ << '[';
+        stack_.emplace_back(false);
+
+        return BaseContext{ *this }; //ArrayItemContext (*this);
+    }
+
+    Writer& Writer::EndArray()
+    {
+        return EndContainer(false, ']', "EndArray");
+    }
+
+    Writer::DictValueContext Writer::Key(std::string_view key)
+    {
+        if (stack_.empty() || !stack_.back().is_dict || stack_.back().has_key) {
+            throw std::logic_error("Key: call outside dictionary or after method Key"s);
+        }
+
+        Level& level = stack_.back();
+        // Dict выводит ключи по возрастанию, потоковый вывод должен совпадать с ним
+        if (!level.is_empty && key <= level.last_key) {
+            throw std::logic_error("Key: keys must be in ascending order"s);
+        }
+
+        const PrintContext ctx = GetContext(stack_.size());
+        if (!level.is_empty) {
+            output_ << ',';
+            ctx.PrintNewLine();
+        }
+        ctx.PrintIndent();
+        // ключи, как и в PrintValue для Dict, выводятся без экранирования
+        output_ << '"' << key << '"' << style_.key_separator;
+
+        level.last_key = key;
+        level.is_empty = false;
+        level.has_key = true;
+
+        return BaseContext{ *this }; //DictValueContext(*this);
+    }
+
+    Writer& Writer::Value(std::nullptr_t)
+    {
+        BeforeValue("Value");
+        PrintValue(nullptr, GetContext(stack_.size()));
+        AfterValue();
+        return *this;
+    }
+
+    Writer& Writer::Value(bool value)
+    {
+        BeforeValue("Value");
+        PrintValue(value, GetContext(stack_.size()));
+        AfterValue();
+        return *this;
+    }
+
+    Writer& Writer::Value(int value)
+    {
+        BeforeValue("Value");
+        PrintValue(value, GetContext(stack_.size()));
+        AfterValue();
+        return *this;
+    }
+
+    Writer& Writer::Value(double value)
+    {
+        BeforeValue("Value");
+        PrintValue(value, GetContext(stack_.size()));
+        AfterValue();
+        return *this;
+    }
+
+    Writer& Writer::Value(std::string_view value)
+    {
+        BeforeValue("Value");
+        PrintValue(value, GetContext(stack_.size()));
+        AfterValue();
+        return *this;
+    }
+
+    Writer& Writer::Value(QuotedString value)
+    {
+        BeforeValue("Value");
+        PrintValue(value, GetContext(stack_.size()));
+        AfterValue();
+        return *this;
+    }
+
+    Writer& Writer::Value(const char* value)
+    {
+        return Value(std::string_view(value));
+    }
+
+    void Writer::Flush()
+    {
+        output_.Flush();
+    }
+
+    PrintContext Writer::GetContext(size_t depth) const
+    {
+        return { output_, style_, static_cast<int>(depth) * style_.indent_step };
+    }
+
+    void Writer::BeforeValue(const char* method)
+    {
+        if (stack_.empty()) {
+            if (is_complete_) {
+                throw std::logic_error(method + ": called after the document is complete"s);
+            }
+            return;
+        }
+
+        Level& level = stack_.back();
+        if (level.is_dict) {
+            // ключ со своим отступом уже выведен
+            if (!level.has_key) {
+                throw std::logic_error(method + ": not called Key method before"s);
+            }
+            level.has_key = false;
+            return;
+        }
+
+        // элемент массива выводится с новой строки, как в PrintValue для Array
+        const PrintContext ctx = GetContext(stack_.size());
+        if (!level.is_empty) {
+            output_ << ',';
+        }
+        ctx.PrintNewLine();
+        ctx.PrintIndent();
+        level.is_empty = false;
+    }
+
+    void Writer::AfterValue()
+    {
+        if (stack_.empty()) {
+            is_complete_ = true;
+        }
+    }
+
+    Writer& Writer::EndContainer(bool is_dict, char bracket, const char* method)
+    {
+        if (stack_.empty() || stack_.back().is_dict != is_dict || stack_.back().has_key) {
+            throw std::logic_error(method + ": no pending calls Start"s + (is_dict ? "Dict"s : "Array"s));
+        }
+
+        stack_.pop_back();
+
+        GetContext(stack_.size() + 1).PrintNewLine();
+        GetContext(stack_.size()).PrintIndent();
+        output_ << bracket;
+
+        AfterValue();
+        return *this;
+    }
+
+
+    Writer::DictItemContext Writer::BaseContext::StartDict()
+    {
+        return writer_.StartDict();
+    }
+
+    Writer& Writer::BaseContext::EndDict()
+    {
+        return writer_.EndDict();
+    }
+
+    Writer::ArrayItemContext Writer::BaseContext::StartArray()
+    {
+        return writer_.StartArray();
+    }
+
+    Writer& Writer::BaseContext::EndArray()
+    {
+        return writer_.EndArray();
+    }
+
+    Writer::DictValueContext Writer::BaseContext::Key(std::string_view key)
+    {
+        return writer_.Key(key);
+    }
+
+    Writer::DictItemContext::DictItemContext(BaseContext base)
+        : BaseContext(base)
+    {}
+
+    Writer::ArrayItemContext::ArrayItemContext(BaseContext base)
+        : BaseContext(base)
+    {}
+
+    Writer::DictValueContext::DictValueContext(BaseContext base)
+        : BaseContext(base)
+    {}
+
+
+} // namespace json
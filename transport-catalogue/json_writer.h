@@ -0,0 +1,128 @@
+#pragma once
+
+#include "json.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+	// Потоковый вывод JSON без построения узлов: значения сразу пишутся в буфер вывода.
+	// Порядок вызовов проверяется на этапе компиляции через контексты
+	// и во время работы исключением std::logic_error.
+	// Ключи словаря должны идти по возрастанию, тогда вывод совпадает с Print словаря Dict
+	class Writer {
+	private:
+		class BaseContext;
+		class DictItemContext;
+		class ArrayItemContext;
+		class DictValueContext;
+
+	public:
+		explicit Writer(OutputBuffer& output, const PrintStyle& style = PrintStyle::PRETTY);
+
+		DictItemContext StartDict();
+		Writer& EndDict();
+		ArrayItemContext StartArray();
+		Writer& EndArray();
+		// ключ должен оставаться действительным до вывода следующего ключа того же словаря
+		DictValueContext Key(std::string_view key);
+
+		Writer& Value(std::nullptr_t);
+		Writer& Value(bool value);
+		Writer& Value(int value);
+		Writer& Value(double value);
+		Writer& Value(std::string_view value);
+		// строка, подготовленная AppendQuoted, копируется без повторного экранирования
+		Writer& Value(QuotedString value);
+		// без этой перегрузки строковый литерал выводился бы как bool
+		Writer& Value(const char* value);
+
+		// передает выведенное в поток, чтобы оно было видно читателю сразу
+		void Flush();
+
+	private:
+		// открытый массив или словарь
+		struct Level {
+			explicit Level(bool dict)
+				: is_dict(dict) {}
+
+			bool is_dict = false;
+			bool is_empty = true;
+			bool has_key = false;  // ключ выведен, значения еще нет
+			std::string_view last_key; // предыдущий ключ словаря, ключи живут дольше вывода словаря (обычно это литералы)
+		};
+
+		OutputBuffer& output_;
+		const PrintStyle& style_;
+		std::vector<Level> stack_;
+		bool is_complete_ = false;
+
+		// контекст вывода для уровня вложенности depth
+		PrintContext GetContext(size_t depth) const;
+		// выводит разделитель и отступ перед очередным значением
+		void BeforeValue(const char* method);
+		void AfterValue();
+		Writer& EndContainer(bool is_dict, char bracket, const char* method);
+
+		class BaseContext {
+		public:
+			BaseContext(Writer& writer)
+				: writer_(writer) {}
+
+			DictItemContext StartDict();
+			Writer& EndDict();
+			ArrayItemContext StartArray();
+			Writer& EndArray();
+			DictValueContext Key(std::string_view key);
+
+			template <typename Type>
+			Writer& Value(const Type& value) {
+				return writer_.Value(value);
+			}
+
+		private:
+			Writer& writer_;
+		};
+
+		class DictItemContext : public BaseContext {
+		public:
+			DictItemContext(BaseContext base);
+
+			DictItemContext StartDict() = delete;
+			ArrayItemContext StartArray() = delete;
+			Writer& EndArray() = delete;
+			template <typename Type>
+			Writer& Value(const Type& value) = delete;
+		};
+
+		class ArrayItemContext : public BaseContext {
+		public:
+			ArrayItemContext(BaseContext base);
+
+			Writer& EndDict() = delete;
+			DictValueContext Key(std::string_view key) = delete;
+
+			template <typename Type>
+			ArrayItemContext Value(const Type& value) {
+				return BaseContext{ BaseContext::Value(value) };
+			}
+		};
+
+		class DictValueContext : public BaseContext {
+		public:
+			DictValueContext(BaseContext base);
+
+			Writer& EndDict() = delete;
+			Writer& EndArray() = delete;
+			DictValueContext Key(std::string_view key) = delete;
+
+			template <typename Type>
+			DictItemContext Value(const Type& value) {
+				return BaseContext{ BaseContext::Value(value) };
+			}
+		};
+	};
+
+} //namespace json
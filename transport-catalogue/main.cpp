@@ -1,6 +1,8 @@
 ﻿
+#include <charconv>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <string_view>
 
 #include "transport_catalogue.h"
@@ -9,15 +11,26 @@
 #include "map_renderer.h"
 #include "transport_router.h"
 #include "serialization.h"
+#include "task_pool.h"
 
 using namespace std::literals;
 
 void PrintUsage(std::ostream& stream = std::cerr) {
-    stream << "Usage: transport_catalogue [make_base|process_requests]\n"sv;
+    stream << "Usage: transport_catalogue [make_base|process_requests [--jsonl|--compact]] [--threads N]\n"sv;
+}
+
+// разбирает число потоков из аргумента --threads, не меньше одного
+std::optional<size_t> ParseThreadCount(std::string_view text) {
+    size_t count = 0;
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), count);
+    if (ec != std::errc{} || ptr != text.data() + text.size() || count == 0) {
+        return std::nullopt;
+    }
+    return count;
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
+    if (argc < 2) {
         PrintUsage();
         return 1;
     }
@@ -25,12 +38,44 @@ int main(int argc, char* argv[]) {
     using namespace transport_catalog;
 
     const std::string_view mode(argv[1]);
+    // запросы и ответы по одному на строку
+    bool is_jsonl = false;
+    // ответы одной строкой без пробелов и переводов строк
+    bool is_compact = false;
+    // число потоков вместе с основным; по умолчанию по числу ядер
+    size_t worker_count = TaskPool::DefaultWorkerCount();
+
+    for (int i = 2; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--jsonl"sv && mode == "process_requests"sv && !is_compact && !is_jsonl) {
+            is_jsonl = true;
+        }
+        else if (arg == "--compact"sv && mode == "process_requests"sv && !is_compact && !is_jsonl) {
+            is_compact = true;
+        }
+        else if (arg == "--threads"sv && i + 1 < argc) {
+            const auto thread_count = ParseThreadCount(argv[++i]);
+            if (!thread_count) {
+                PrintUsage();
+                return 1;
+            }
+            // одним из потоков работает основной
+            worker_count = *thread_count - 1;
+        }
+        else {
+            PrintUsage();
+            return 1;
+        }
+    }
 
-    TransportCatalogue tc;
-    TransportRouter transport_router;
-    renderer::MapRenderer map_renderer;
+    // потоки не согласуются с stdio: ввод читается блоками из буфера потока, а не по символу
+    std::ios::sync_with_stdio(false);
+
+    // потоки для построения снимка каталога, графа и карты; содержимое базы от их числа не зависит
+    TaskPool pool(worker_count);
+    SnapshotHolder snapshots;
     Serialization serializetion;
-    RequestHandler rh{ tc, map_renderer, transport_router, serializetion };
+    RequestHandler rh{ snapshots, serializetion, pool };
 
     if (mode == "make_base"sv) {
 
@@ -38,7 +83,8 @@ int main(int argc, char* argv[]) {
 
         std::ofstream outfile(serializetion.GetFileName(), std::ios::binary);
         if (outfile.is_open()) {
-            serializetion.Serialize(outfile, tc, map_renderer, transport_router);
+            const auto snapshot = snapshots.Acquire();
+            serializetion.Serialize(outfile, snapshot->catalogue, snapshot->renderer, snapshot->router, pool);
         }
 
         outfile.close();
@@ -46,8 +92,12 @@ int main(int argc, char* argv[]) {
     }
     else if (mode == "process_requests"sv) {
         
-        json::Document doc = rh.ProcessRequests(std::cin);
-        json::Print(doc, std::cout);
+        if (is_jsonl) {
+            rh.ProcessRequestLines(std::cin, std::cout);
+        }
+        else {
+            rh.ProcessRequests(std::cin, std::cout, is_compact ? json::PrintStyle::COMPACT : json::PrintStyle::PRETTY);
+        }
 
     }
     else {
@@ -0,0 +1,139 @@
+// Проверка make_base: база, собранная одним потоком и несколькими, должна совпадать побайтно.
+// Строит синтетический каталог, выполняет для него make_base с разным числом потоков
+// и сравнивает файлы баз. Завершается с кодом 1, если базы различаются
+#include "json.h"
+#include "request_handler.h"
+#include "serialization.h"
+#include "task_pool.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using namespace transport_catalog;
+
+    // входные данные make_base: остановки с дорожными расстояниями, автобусы и все настройки
+    std::string MakeBaseInput(int stop_count, int bus_count) {
+        std::mt19937 generator(2024);
+        std::uniform_real_distribution<double> lat(55.5, 55.8);
+        std::uniform_real_distribution<double> lng(37.3, 37.8);
+        std::uniform_int_distribution<int> distance(100, 5000);
+        std::uniform_int_distribution<int> stop_index(0, stop_count - 1);
+        std::uniform_int_distribution<int> route_size(2, 8);
+
+        std::vector<std::string> names;
+        for (int i = 0; i < stop_count; ++i) {
+            names.push_back((i % 3 == 0 ? "Улица " : i % 3 == 1 ? "Stop " : "Площадь ") + std::to_string(i));
+        }
+
+        json::Array base_requests;
+        for (int i = 0; i < stop_count; ++i) {
+            json::Dict road_distances;
+            for (int j = 0; j < 4; ++j) {
+                road_distances.emplace(names[stop_index(generator)], distance(generator));
+            }
+            base_requests.emplace_back(json::Dict{
+                { "type", std::string("Stop") },
+                { "name", names[i] },
+                { "latitude", lat(generator) },
+                { "longitude", lng(generator) },
+                { "road_distances", std::move(road_distances) },
+            });
+        }
+        for (int i = 0; i < bus_count; ++i) {
+            json::Array stops;
+            const int size = route_size(generator);
+            for (int j = 0; j < size; ++j) {
+                stops.emplace_back(names[stop_index(generator)]);
+            }
+            const bool is_roundtrip = i % 2 == 0;
+            if (is_roundtrip) {
+                stops.push_back(stops.front());
+            }
+            base_requests.emplace_back(json::Dict{
+                { "type", std::string("Bus") },
+                { "name", std::to_string(i) + (i % 4 == 1 ? "к" : "") },
+                { "stops", std::move(stops) },
+                { "is_roundtrip", is_roundtrip },
+            });
+        }
+
+        json::Dict input{
+            { "serialization_settings", json::Dict{ { "file", std::string("unused.db") }, { "store_rendered_map", true } } },
+            { "routing_settings", json::Dict{ { "bus_wait_time", 6 }, { "bus_velocity", 40 } } },
+            { "render_settings", json::Dict{
+                { "width", 1200.0 }, { "height", 1200.0 }, { "padding", 50.0 },
+                { "line_width", 14.0 }, { "stop_radius", 5.0 },
+                { "bus_label_font_size", 20 }, { "bus_label_offset", json::Array{ 7.0, 15.0 } },
+                { "stop_label_font_size", 20 }, { "stop_label_offset", json::Array{ 7.0, -3.0 } },
+                { "underlayer_color", json::Array{ 255, 255, 255, 0.85 } }, { "underlayer_width", 3.0 },
+                { "color_palette", json::Array{ std::string("green"), json::Array{ 255, 160, 0 }, std::string("red") } },
+            } },
+            { "base_requests", std::move(base_requests) },
+        };
+
+        std::ostringstream output;
+        json::Print(json::Document{ std::move(input) }, output);
+        return output.str();
+    }
+
+    // выполняет make_base на пуле из thread_count потоков и возвращает содержимое файла базы
+    std::string MakeBase(const std::string& input, size_t thread_count, const std::string& file_name) {
+        TaskPool pool(thread_count - 1);
+        SnapshotHolder snapshots;
+        Serialization serialization;
+        RequestHandler handler{ snapshots, serialization, pool };
+
+        std::istringstream input_stream(input);
+        handler.MakeBaseRequests(input_stream);
+        {
+            std::ofstream output(file_name, std::ios::binary);
+            const auto snapshot = snapshots.Acquire();
+            serialization.Serialize(output, snapshot->catalogue, snapshot->renderer, snapshot->router, pool);
+        }
+
+        std::ifstream base(file_name, std::ios::binary);
+        std::string result{ std::istreambuf_iterator<char>(base), std::istreambuf_iterator<char>() };
+        base.close();
+        std::remove(file_name.c_str());
+        return result;
+    }
+
+}   // namespace
+
+int main(int argc, char* argv[]) {
+    // число потоков для сравнения с однопоточной сборкой
+    const size_t thread_count = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 8;
+    if (thread_count < 2) {
+        std::cerr << "Usage: make_base_check [thread_count >= 2]\n";
+        return 1;
+    }
+
+    const std::string input = MakeBaseInput(3000, 600);
+    const std::string expected = MakeBase(input, 1, "make_base_check_1.db");
+    if (expected.empty()) {
+        std::cout << "FAIL: empty base\n";
+        return 1;
+    }
+
+    // многопоточная сборка повторяется, чтобы потоки успели выполнить задачи в разном порядке
+    constexpr int RUN_COUNT = 3;
+    for (int run = 0; run < RUN_COUNT; ++run) {
+        const std::string actual = MakeBase(input, thread_count, "make_base_check_n.db");
+        if (actual != expected) {
+            std::cout << "FAIL: base built by " << thread_count << " threads differs from the one-thread base\n";
+            return 1;
+        }
+    }
+
+    std::cout << "OK: " << expected.size() << " bytes, identical for 1 and " << thread_count << " threads\n";
+    return 0;
+}
@@ -1,4 +1,7 @@
 #include "map_renderer.h"
+#include "json.h"
+
+#include <stdexcept>
 
 
 namespace transport_catalog {
@@ -97,7 +100,11 @@ namespace transport_catalog {
         {}
 
         void MapRenderer::SetSettings(MapSettings& new_settings) {
+            std::lock_guard lock(render_mutex_);
             map_settings_ = new_settings;
+            // настройки меняются до того, как рендерер станут читать другие потоки
+            cache_ = nullptr;
+            v_caches_.clear();
         }
 
         const MapSettings& MapRenderer::GetSettings() const {
@@ -116,6 +123,61 @@ namespace transport_catalog {
             return map_settings_.padding;
         }
 
+        std::shared_ptr<const RenderedMap> MapRenderer::GetRenderedMap(const TransportCatalogue& catalogue) const {
+
+            const uint64_t generation = catalogue.GetGeneration();
+            // каталог еще может измениться, поэтому его карта не запоминается
+            if (generation == 0) {
+                auto rendered = std::make_shared<RenderedMap>();
+                RenderMap(catalogue.GetAllBuses()).Render(rendered->svg);
+                json::AppendQuoted(rendered->json, rendered->svg);
+                return rendered;
+            }
+
+            const auto is_actual = [generation](const MapCache* cache) {
+                return cache && cache->generation == generation;
+            };
+
+            if (const MapCache* cache = cache_.load(); is_actual(cache)) {
+                return cache->map;
+            }
+
+            std::lock_guard lock(render_mutex_);
+            // пока ждали, карту мог отрисовать другой поток
+            if (const MapCache* cache = cache_.load(); is_actual(cache)) {
+                return cache->map;
+            }
+
+            std::string svg;
+            RenderMap(catalogue.GetAllBuses()).Render(svg);
+
+            return StoreRenderedMap(std::move(svg), generation);
+        }
+
+        void MapRenderer::SetRenderedMap(std::string svg, const TransportCatalogue& catalogue) {
+            if (!catalogue.IsFrozen()) {
+                throw std::logic_error("Rendered map requires a frozen catalogue");
+            }
+            std::lock_guard lock(render_mutex_);
+            StoreRenderedMap(std::move(svg), catalogue.GetGeneration());
+        }
+
+        std::shared_ptr<const RenderedMap> MapRenderer::StoreRenderedMap(std::string svg, uint64_t generation) const {
+
+            auto rendered = std::make_shared<RenderedMap>();
+            rendered->svg = std::move(svg);
+            json::AppendQuoted(rendered->json, rendered->svg);
+
+            auto cache = std::make_unique<MapCache>();
+            cache->generation = generation;
+            cache->map = std::move(rendered);
+            v_caches_.push_back(std::move(cache));
+            // указатель публикуется, когда карта уже заполнена
+            cache_ = v_caches_.back().get();
+
+            return v_caches_.back()->map;
+        }
+
         svg::Document MapRenderer::RenderMap(const std::unordered_map<std::string_view, Bus*>& un_buses) const {
             
             svg::Document doc_svg;
@@ -146,7 +208,10 @@ namespace transport_catalog {
             const size_t color_max_number = map_settings.color_palette.size() - 1;
 
             std::vector<svg::Text> layer2; // содержит надписи и подложки		
-            std::set<Stop*> s_stops; // содержит уникальные остановки для отрисовки третьего и четвертого слоев
+            std::vector<Stop*> v_stops; // уникальные остановки для отрисовки третьего и четвертого слоев
+            // отметки уже собранных остановок, переиспользуются между вызовами
+            thread_local VisitedSet visited_stops;
+            visited_stops.Reset(0);
 
             for (const auto& [name, bus_ptr] : ordered_buses) {
 
@@ -179,19 +244,20 @@ namespace transport_catalog {
                     );
                 }
 
-                s_stops.insert(bus_ptr->stops.begin(), bus_ptr->stops.end());
+                for (Stop* stop_ptr : bus_ptr->stops) {
+                    if (visited_stops.Insert(stop_ptr->id)) {
+                        v_stops.push_back(stop_ptr);
+                    }
+                }
 
                 ++index_color;
             }
 
             // добавим второй слой на карту
             for (svg::Text& t : layer2) {
-                doc_svg.Add(t);
+                doc_svg.Add(std::move(t));
             }
 
-            // переложим в вектор, чтобы можно было отсортировать
-            std::vector<Stop*> v_stops(s_stops.begin(), s_stops.end());
-
             std::sort(v_stops.begin(), v_stops.end(), [](const Stop* lhs, const Stop* rhs) { return lhs->name < rhs->name; });
             // добавим третий и четвертый слои
             PointStops(doc_svg, proj, v_stops, map_settings);
@@ -199,7 +265,7 @@ namespace transport_catalog {
             return doc_svg;
         }
 
-        void MapRenderer::Routes(svg::Document& doc, const SphereProjector& proj, const std::vector<Stop*>& v_stops, const MapSettings& settings, const size_t color_number, const bool is_roundtrip) const {
+        void MapRenderer::Routes(svg::Document& doc, const SphereProjector& proj, const StopsSpan& v_stops, const MapSettings& settings, const size_t color_number, const bool is_roundtrip) const {
             
             svg::Polyline line_of_bus;
 
@@ -254,8 +320,8 @@ namespace transport_catalog {
             }
 
             // добавим названия остановок
-            for (svg::Text t : v_stop_names) {
-                doc.Add(t);
+            for (svg::Text& t : v_stop_names) {
+                doc.Add(std::move(t));
             }
 
         }
@@ -3,13 +3,17 @@
 #include "svg.h"
 #include "geo.h"
 #include "domain.h"
+#include "transport_catalogue.h"
+#include "visited_set.h"
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
-#include <set>
 
 namespace transport_catalog {
     
@@ -60,6 +64,12 @@ namespace transport_catalog {
             double zoom_coeff_ = 0;
         };
 
+        // Отрисованная карта: текст SVG и он же в виде строки JSON (в кавычках, с экранированием)
+        struct RenderedMap {
+            std::string svg;
+            std::string json;
+        };
+
         class MapRenderer {
         public:
             MapRenderer() = default;
@@ -72,11 +82,31 @@ namespace transport_catalog {
             double GetHeight() const;
             double GetPadding() const;
             svg::Document RenderMap(const std::unordered_map<std::string_view, Bus*>& un_buses) const;
+            // Возвращает карту каталога, отрисованную один раз для текущих настроек.
+            // Безопасно вызывается из нескольких потоков. Карта привязана к поколению каталога и перерисовывается
+            // после SetSettings или для каталога другого поколения. Карта незаполненного каталога не запоминается
+            std::shared_ptr<const RenderedMap> GetRenderedMap(const TransportCatalogue& catalogue) const;
+            // Запоминает готовую карту svg заполненного каталога, например загруженную из базы.
+            // Вызывается после SetSettings, иначе карта будет сброшена
+            void SetRenderedMap(std::string svg, const TransportCatalogue& catalogue);
 
         private:
-            MapSettings map_settings_;
+            // карта и поколение каталога, по которому она отрисована
+            struct MapCache {
+                uint64_t generation = 0;
+                std::shared_ptr<const RenderedMap> map;
+            };
 
-            void Routes(svg::Document& doc, const SphereProjector& proj, const std::vector<Stop*>& v_stops, const MapSettings& settings, const size_t color_number, const bool is_roundtrip) const;
+            MapSettings map_settings_;
+            // Текущая карта читается без блокировок. Замененные карты не освобождаются до SetSettings,
+            // так как их еще могут читать другие потоки
+            mutable std::atomic<const MapCache*> cache_{ nullptr };
+            mutable std::vector<std::unique_ptr<const MapCache>> v_caches_; // все отрисованные карты, меняется под render_mutex_
+            mutable std::mutex render_mutex_;   // отрисовку выполняет один поток, остальные ждут готовую карту
+
+            // кладет карту в кэш, вызывается под render_mutex_
+            std::shared_ptr<const RenderedMap> StoreRenderedMap(std::string svg, uint64_t generation) const;
+            void Routes(svg::Document& doc, const SphereProjector& proj, const StopsSpan& v_stops, const MapSettings& settings, const size_t color_number, const bool is_roundtrip) const;
             void PointStops(svg::Document& doc, const renderer::SphereProjector& proj, std::vector<Stop*>& v_stops, const renderer::MapSettings& settings) const;
             svg::Text AddRouteName(const renderer::MapSettings& settings, const std::string& font_family, const std::string& font_wight, const svg::Point screen_coord, const std::string_view& name, const size_t index_color, const bool is_substrate) const;
             svg::Text AddStopName(const renderer::MapSettings& settings, const std::string& font_family, const svg::Point screen_coord, const std::string_view& name, const bool is_substrate) const;
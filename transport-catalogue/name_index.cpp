@@ -0,0 +1,288 @@
+#include "name_index.h"
+#include "visited_set.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace transport_catalog {
+
+    namespace detail {
+
+        // разбирает кодовую точку UTF-8, начинающуюся в text[pos], и сдвигает pos за нее
+        uint32_t DecodeCodePoint(std::string_view text, size_t& pos) {
+            const unsigned char ch = static_cast<unsigned char>(text[pos]);
+            size_t length = 1;
+            uint32_t code = ch;
+            if (ch >= 0xF0) { length = 4; code = ch & 0x07; }
+            else if (ch >= 0xE0) { length = 3; code = ch & 0x0F; }
+            else if (ch >= 0xC0) { length = 2; code = ch & 0x1F; }
+
+            for (size_t k = 1; k < length && pos + k < text.size(); ++k) {
+                code = (code << 6) | (static_cast<unsigned char>(text[pos + k]) & 0x3F);
+            }
+            pos = std::min(pos + length, text.size());
+            return code;
+        }
+
+        // разбирает строку UTF-8 на кодовые точки
+        void DecodeUtf8(std::string_view text, std::vector<uint32_t>& out) {
+            out.clear();
+            for (size_t i = 0; i < text.size();) {
+                out.push_back(DecodeCodePoint(text, i));
+            }
+        }
+
+        namespace {
+
+            // символы, после которых начинается новое слово
+            bool IsWordSeparator(char ch) {
+                return ch == ' ' || ch == '-' || ch == '"' || ch == '(' || ch == '.' || ch == ',' || ch == '/';
+            }
+
+        }   // namespace
+
+        std::string NormalizeName(std::string_view name) {
+            std::string result;
+            result.reserve(name.size());
+
+            for (size_t i = 0; i < name.size(); ++i) {
+                const unsigned char ch = static_cast<unsigned char>(name[i]);
+
+                if (ch >= 'A' && ch <= 'Z') {
+                    result.push_back(static_cast<char>(ch - 'A' + 'a'));
+                }
+                else if (ch == 0xD0 && i + 1 < name.size()) {
+                    // кириллица: А-П -> а-п, Р-Я -> р-я, Ё -> ё
+                    const unsigned char next = static_cast<unsigned char>(name[++i]);
+                    if (next >= 0x90 && next <= 0x9F) {
+                        result.push_back(static_cast<char>(0xD0));
+                        result.push_back(static_cast<char>(next + 0x20));
+                    }
+                    else if (next >= 0xA0 && next <= 0xAF) {
+                        result.push_back(static_cast<char>(0xD1));
+                        result.push_back(static_cast<char>(next - 0x20));
+                    }
+                    else if (next == 0x81) {
+                        result.push_back(static_cast<char>(0xD1));
+                        result.push_back(static_cast<char>(0x91));
+                    }
+                    else {
+                        result.push_back(static_cast<char>(ch));
+                        result.push_back(static_cast<char>(next));
+                    }
+                }
+                else {
+                    result.push_back(static_cast<char>(ch));
+                }
+            }
+
+            return result;
+        }
+
+    }   // namespace detail
+
+    void NameIndex::Build(const std::deque<Stop>& stops, const std::deque<Bus>& buses) {
+
+        keys_arena_.clear();
+        v_names_.clear();
+        v_suffixes_.clear();
+        v_names_.reserve(stops.size() + buses.size());
+
+        auto add_name = [this](std::string_view name, bool is_bus) {
+            const std::string key = detail::NormalizeName(name);
+            v_names_.push_back({ name, is_bus, static_cast<uint32_t>(keys_arena_.size()), static_cast<uint32_t>(key.size()) });
+            keys_arena_ += key;
+        };
+
+        for (const Stop& stop : stops) {
+            add_name(stop.name, false);
+        }
+        for (const Bus& bus : buses) {
+            add_name(bus.name, true);
+        }
+
+        std::sort(v_names_.begin(), v_names_.end(), [this](const NameEntry& lhs, const NameEntry& rhs) {
+            return std::tuple{ GetKey(lhs), lhs.is_bus, lhs.name } < std::tuple{ GetKey(rhs), rhs.is_bus, rhs.name };
+        });
+
+        for (size_t index = 0; index < v_names_.size(); ++index) {
+            const NameEntry& entry = v_names_[index];
+            const std::string_view key = GetKey(entry);
+
+            for (size_t pos = 0; pos < key.size(); ++pos) {
+                if (pos == 0 || (detail::IsWordSeparator(key[pos - 1]) && !detail::IsWordSeparator(key[pos]))) {
+                    v_suffixes_.push_back({ static_cast<uint32_t>(index), static_cast<uint32_t>(entry.key_begin + pos) });
+                }
+            }
+        }
+
+        std::stable_sort(v_suffixes_.begin(), v_suffixes_.end(), [this](const SuffixEntry& lhs, const SuffixEntry& rhs) {
+            return GetSuffix(lhs) < GetSuffix(rhs);
+        });
+
+    }
+
+    std::vector<NameMatch> NameIndex::Suggest(std::string_view query, size_t limit) const {
+
+        std::vector<NameMatch> result;
+
+        const std::string key = detail::NormalizeName(query);
+        if (key.empty() || limit == 0) {
+            return result;
+        }
+
+        // найденные имена: (ранг, номер имени), одно имя может встретиться с разными рангами.
+        // Номера имен упорядочены так же, как имена
+        thread_local std::vector<std::pair<size_t, uint32_t>> v_found;
+        thread_local VisitedSet found_names;
+        v_found.clear();
+        found_names.Reset(v_names_.size());
+        size_t names_found = 0;
+
+        // совпадения по началу имени (ранг 0) или по началу слова внутри имени (ранг 1)
+        auto it = std::lower_bound(v_suffixes_.begin(), v_suffixes_.end(), key, [this](const SuffixEntry& entry, const std::string& value) {
+            return GetSuffix(entry) < value;
+        });
+        for (; it != v_suffixes_.end() && GetSuffix(*it).substr(0, key.size()) == key; ++it) {
+            const NameEntry& entry = v_names_[it->name_index];
+            const size_t rank = (it->key_pos == entry.key_begin) ? 0 : 1;
+            v_found.push_back({ rank, it->name_index });
+            if (found_names.Insert(it->name_index)) {
+                ++names_found;
+            }
+        }
+
+        // похожие имена с опечатками в начале имени или в начале слова (ранг 2 + число правок).
+        // Ищутся, только если точных совпадений нет или почти нет
+        if (names_found < std::min(limit, FEW_PREFIX_MATCHES)) {
+            thread_local std::vector<uint32_t> v_query;
+            detail::DecodeUtf8(key, v_query);
+            // в длинном запросе допускаем две опечатки, в коротком - одну
+            const size_t max_distance = v_query.size() > 5 ? 2 : 1;
+
+            FindSimilar(v_query, max_distance, v_found);
+        }
+
+        std::sort(v_found.begin(), v_found.end());
+
+        // у каждого имени остается лучший ранг
+        found_names.Reset(v_names_.size());
+        for (const auto& [rank, index] : v_found) {
+            if (result.size() == limit) {
+                break;
+            }
+            if (found_names.Insert(index)) {
+                result.push_back({ v_names_[index].name, v_names_[index].is_bus });
+            }
+        }
+
+        return result;
+    }
+
+    // Начала слов отсортированы, поэтому соседние записи образуют дерево по общим началам.
+    // Строки таблицы правок считаются по одной на символ пути и переиспользуются для общего начала
+    // соседних записей. Если все значения строки больше max_distance, дальше они только растут,
+    // поэтому все записи с этим началом получают один и тот же результат и пропускаются разом
+    void NameIndex::FindSimilar(const std::vector<uint32_t>& v_query, size_t max_distance, std::vector<std::pair<size_t, uint32_t>>& v_found) const {
+
+        const size_t query_size = v_query.size();
+        const size_t row_size = query_size + 1;
+
+        // для глубины d (числа символов пути): v_rows - строка таблицы правок между началами запроса
+        // и пути, v_best - наименьшее число правок, за которое запрос превращается в начало пути,
+        // v_path_ends - длина пути в байтах, v_path - символ пути
+        thread_local std::vector<size_t> v_rows, v_best, v_path_ends;
+        thread_local std::vector<uint32_t> v_path;
+
+        v_rows.resize(row_size);
+        for (size_t i = 0; i <= query_size; ++i) {
+            v_rows[i] = i;
+        }
+        v_best.assign(1, query_size);
+        v_path_ends.assign(1, 0);
+        v_path.clear();
+        std::string_view path;
+
+        // записывает найденными записи [first, last), если число правок допустимо
+        auto add_range = [&](size_t first, size_t last, size_t distance) {
+            if (distance > max_distance) {
+                return;
+            }
+            for (size_t i = first; i < last; ++i) {
+                v_found.push_back({ 2 + distance, v_suffixes_[i].name_index });
+            }
+        };
+
+        // первая запись после first, которая не начинается с prefix
+        auto range_end = [this](size_t first, std::string_view prefix) {
+            return static_cast<size_t>(std::upper_bound(v_suffixes_.begin() + first, v_suffixes_.end(), prefix,
+                [this](std::string_view value, const SuffixEntry& entry) {
+                    return value < GetSuffix(entry).substr(0, value.size());
+                }) - v_suffixes_.begin());
+        };
+
+        for (size_t index = 0; index < v_suffixes_.size();) {
+            const std::string_view suffix = GetSuffix(v_suffixes_[index]);
+
+            // общее с путем начало, целыми символами
+            const size_t common_bytes = std::mismatch(path.begin(), path.begin() + std::min(path.size(), suffix.size()), suffix.begin()).first - path.begin();
+            size_t depth = std::upper_bound(v_path_ends.begin(), v_path_ends.end(), common_bytes) - v_path_ends.begin() - 1;
+            v_path_ends.resize(depth + 1);
+            v_best.resize(depth + 1);
+            v_path.resize(depth);
+            path = suffix;
+
+            size_t pos = v_path_ends[depth];
+            size_t next = index + 1;
+            while (pos < suffix.size()) {
+                if (v_best[depth] == 0) {
+                    // запрос уже совпал с началом пути, так же совпадет и у следующих записей с этим началом
+                    next = range_end(index, suffix.substr(0, pos));
+                    break;
+                }
+
+                const uint32_t symbol = detail::DecodeCodePoint(suffix, pos);
+                v_path.push_back(symbol);
+                ++depth;
+                v_path_ends.push_back(pos);
+                v_rows.resize((depth + 1) * row_size);
+
+                const size_t* prev_prev = depth > 1 ? &v_rows[(depth - 2) * row_size] : nullptr;
+                const size_t* prev = &v_rows[(depth - 1) * row_size];
+                size_t* curr = &v_rows[depth * row_size];
+
+                curr[0] = depth;
+                size_t row_min = curr[0];
+                for (size_t i = 1; i <= query_size; ++i) {
+                    const size_t replace = prev[i - 1] + (v_query[i - 1] == symbol ? 0 : 1);
+                    curr[i] = std::min({ prev[i] + 1, curr[i - 1] + 1, replace });
+                    // перестановка двух соседних символов считается одной правкой
+                    if (prev_prev && i > 1 && v_query[i - 1] == v_path[depth - 2] && v_query[i - 2] == symbol) {
+                        curr[i] = std::min(curr[i], prev_prev[i - 2] + 1);
+                    }
+                    row_min = std::min(row_min, curr[i]);
+                }
+                v_best.push_back(std::min(v_best[depth - 1], curr[query_size]));
+
+                if (row_min > max_distance) {
+                    // продолжения пути хуже, результат у всех записей с этим началом одинаковый
+                    next = range_end(index, suffix.substr(0, pos));
+                    break;
+                }
+            }
+
+            add_range(index, next, v_best[depth]);
+            index = next;
+        }
+    }
+
+    std::string_view NameIndex::GetKey(const NameEntry& entry) const {
+        return std::string_view{ keys_arena_ }.substr(entry.key_begin, entry.key_size);
+    }
+
+    std::string_view NameIndex::GetSuffix(const SuffixEntry& entry) const {
+        const NameEntry& name = v_names_[entry.name_index];
+        return std::string_view{ keys_arena_ }.substr(entry.key_pos, name.key_begin + name.key_size - entry.key_pos);
+    }
+
+}   // namespace transport_catalog
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "domain.h"
+
+namespace transport_catalog {
+
+    // найденное по запросу имя остановки или автобуса
+    struct NameMatch {
+        std::string_view name;
+        bool is_bus = false;
+    };
+
+    // Индекс имен остановок и автобусов для подсказок по части имени или имени с опечаткой.
+    // Хранит отсортированные начала слов приведенных к нижнему регистру имен
+    class NameIndex {
+    public:
+        NameIndex() = default;
+
+        // строит индекс по остановкам и автобусам каталога
+        void Build(const std::deque<Stop>& stops, const std::deque<Bus>& buses);
+        // возвращает не более limit имен: сначала начинающиеся с запроса,
+        // затем содержащие слово, начинающееся с запроса, затем похожие с точностью до опечаток
+        std::vector<NameMatch> Suggest(std::string_view query, size_t limit) const;
+
+    private:
+        struct NameEntry {
+            std::string_view name;
+            bool is_bus = false;
+            uint32_t key_begin = 0; // положение нормализованного имени в keys_arena_
+            uint32_t key_size = 0;
+        };
+
+        struct SuffixEntry {
+            uint32_t name_index = 0; // номер имени в v_names_
+            uint32_t key_pos = 0;    // начало слова в keys_arena_
+        };
+
+        std::string keys_arena_;             // нормализованные имена подряд
+        std::vector<NameEntry> v_names_;     // отсортированы по нормализованному имени
+        std::vector<SuffixEntry> v_suffixes_; // начала слов, отсортированы по продолжению имени с этого места
+
+        // при меньшем числе совпадений по началу ищутся имена с опечатками
+        static constexpr size_t FEW_PREFIX_MATCHES = 3;
+
+        std::string_view GetKey(const NameEntry& entry) const;
+        std::string_view GetSuffix(const SuffixEntry& entry) const;
+        // добавляет в v_found начала слов, в которые запрос превращается не более чем за max_distance правок
+        void FindSimilar(const std::vector<uint32_t>& v_query, size_t max_distance, std::vector<std::pair<size_t, uint32_t>>& v_found) const;
+    };
+
+    namespace detail {
+        // приводит латинские и русские буквы к нижнему регистру
+        std::string NormalizeName(std::string_view name);
+        // разбирает строку UTF-8 на кодовые точки
+        void DecodeUtf8(std::string_view text, std::vector<uint32_t>& out);
+        // разбирает кодовую точку UTF-8, начинающуюся в text[pos], и сдвигает pos за нее
+        uint32_t DecodeCodePoint(std::string_view text, size_t& pos);
+    }
+
+}   // namespace transport_catalog
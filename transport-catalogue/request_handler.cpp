@@ -1,5 +1,6 @@
 #include "request_handler.h"
 
+#include <cmath>
 
 namespace transport_catalog {
 	
@@ -16,9 +17,9 @@ namespace transport_catalog {
 		}
 	}
 
-	std::optional<BusStat> RequestHandler::GetBusStat(const std::string_view& bus_name) const {
+	std::optional<BusStat> RequestHandler::GetBusStat(const CatalogueSnapshot& snapshot, const std::string_view& bus_name) const {
 		
-		const Bus* bus = db_.GetBusInfo(bus_name);
+		const Bus* bus = snapshot.catalogue.GetBusInfo(bus_name);
 		if (!bus) {
 			return std::nullopt;
 		}
@@ -26,177 +27,327 @@ namespace transport_catalog {
 		size_t count = bus->stops.size();
 		if (!bus->is_roundtrip) { count = (count * 2) - 1; }
 
-		size_t unique_count = GetUniqueStops(bus->stops);
-		double route_length = GetLengthOfDistance(bus->stops, bus->is_roundtrip);
-		double geo_route_length = GetGeoLengthOfDistance(bus->stops, bus->is_roundtrip);
-		
-		return std::optional<BusStat>({bus_name, geo_route_length, route_length, count, unique_count});
+		// длины и уникальные остановки посчитаны при заморозке каталога
+		return std::optional<BusStat>({bus_name, bus->geo_route_length, bus->route_length, count, bus->unique_stop_count});
 	}
 
-	std::optional<std::set<std::string_view>*> RequestHandler::GetBusesByStop(const std::string_view& stop_name) const {
-		std::tuple<bool, std::set<std::string_view>*> tup_buses = db_.GetStopInfo(stop_name);
+	std::optional<TransportCatalogue::BusesRange> RequestHandler::GetBusesByStop(const CatalogueSnapshot& snapshot, const std::string_view& stop_name) const {
+		return snapshot.catalogue.GetStopInfo(stop_name);
+	}
 
-		if (std::get<0>(tup_buses)) {
-			return std::optional<std::set<std::string_view>*>(std::get<1>(tup_buses));
+	// Заполняет новый снимок по мере чтения make_base: остановки добавляются сразу,
+	// автобусы и расстояния - в Finish, когда известны все остановки
+	class RequestHandler::MakeBaseConsumer final : public RequestsConsumer {
+	public:
+		MakeBaseConsumer(RequestHandler& handler, CatalogueSnapshot& snapshot)
+			: handler_(handler)
+			, snapshot_(snapshot)
+		{}
+
+		void OnBaseRequest(const json::ArenaDict& request) override {
+			handler_.ToBase(snapshot_.catalogue, request, pending_);
 		}
-		
-		return std::optional<std::set<std::string_view>*>();
-	}
 
-	const std::unordered_map<std::string_view, Bus*>& RequestHandler::GetAllBuses() const {
-		return db_.GetAllBuses();
-	}
+		void OnStatRequest(json::Dict) override {}
 
-	void  RequestHandler::MakeBaseRequests(std::istream& input) {
-		JSONReader json_reader;
-		const Requests requests = json_reader.Read(input);
+		void OnRenderSettings(json::Dict settings) override {
+			if (settings.size()) {
+				handler_.SettingsForMap(snapshot_, settings);
+			}
+		}
 
-		// запросы на добавление информации в базу
-		if (requests.base_requests.size()) {
-			ToBase(requests.base_requests);
+		void OnRoutingSettings(json::Dict settings) override {
+			if (settings.size()) {
+				handler_.SetRoutingSettings(snapshot_, settings);
+			}
 		}
-		
-		// запрос настроек для карты
-		if (requests.render_settings.size()) {
-			SettingsForMap(requests.render_settings);
+
+		void OnSerializationSettings(json::Dict settings) override {
+			if (settings.size()) {
+				handler_.SetSerialization(settings);
+			}
 		}
-		
-		// запрос настроек маршрутизации (время ожидания автобуса и скорость автобуса)
-		if (requests.routing_settings.size()) {
-			SetRoutingSettings(requests.routing_settings);
+
+		// все остановки известны, добавим расстояния и автобусы
+		void Finish() {
+			handler_.ResolvePendingBase(snapshot_.catalogue, pending_);
 		}
-		
-		// запрос настроек сериализации
-		if (requests.serialization_settings.size()) {
-			SetSerialization(requests.serialization_settings);
+
+	private:
+		RequestHandler& handler_;
+		CatalogueSnapshot& snapshot_;
+		PendingBase pending_;
+	};
+
+	// Отвечает на запросы process_requests по мере чтения и выводит ответы в буфер вывода.
+	// Запросы, прочитанные раньше настроек сериализации, ждут загрузки базы
+	class RequestHandler::ProcessRequestsConsumer final : public RequestsConsumer {
+	public:
+		ProcessRequestsConsumer(RequestHandler& handler, json::Writer& answers)
+			: handler_(handler)
+			, answers_(answers)
+		{}
+
+		void OnBaseRequest(const json::ArenaDict&) override {}
+
+		void OnStatRequest(json::Dict request) override {
+			if (is_base_loaded_) {
+				AddAnswer(request);
+			}
+			else {
+				pending_requests_.push_back(std::move(request));
+			}
 		}
-	}
 
-	json::Document RequestHandler::ProcessRequests(std::istream& input) {
-		JSONReader json_reader;
-		const Requests requests = json_reader.Read(input);
-		
-		// запрос настроек сериализации
-		if (requests.serialization_settings.size()) {
-			SetSerialization(requests.serialization_settings);			
-			FillOutFromFile();
+		void OnRenderSettings(json::Dict) override {}
+
+		void OnRoutingSettings(json::Dict) override {}
+
+		void OnSerializationSettings(json::Dict settings) override {
+			if (settings.size()) {
+				handler_.SetSerialization(settings);
+				handler_.snapshots_.Publish(handler_.LoadFromFile(handler_.serialization_.GetFileName()));
+				is_base_loaded_ = true;
+				// отложенные запросы отвечаются по загруженной базе
+				AnswerPending();
+			}
+		}
+
+		// отвечает на отложенные запросы и завершает массив ответов
+		void Finish() {
+			AnswerPending();
+			answers_.EndArray();
+			answers_.Flush();
 		}
 
-		// запросы к траспортному каталогу
-		json::Array arr_answers;
-		if (requests.stat_requests.size()) {
-			// сначала построим граф
-			transport_router_.BuildGraph(db_);
+	private:
+		RequestHandler& handler_;
+		json::Writer& answers_;
+		bool is_base_loaded_ = false;
+		std::vector<json::Dict> pending_requests_;
 
-			arr_answers = ToTransportCataloque(requests.stat_requests);
+		// выводит ответ элементом массива. В поток ответы уходят блоками по мере заполнения буфера
+		// и в конце массива, ответ на каждый запрос сразу передают только в режиме JSON Lines
+		void AddAnswer(const json::Dict& request) {
+			handler_.ToTransportCataloque(request, answers_);
 		}
 
-		return json::Document{ arr_answers };
-	}	
+		void AnswerPending() {
+			for (const json::Dict& request : pending_requests_) {
+				AddAnswer(request);
+			}
+			pending_requests_.clear();
+		}
+	};
 
-	void RequestHandler::ToBase(const json::Array& arr_nodes) {
+	void  RequestHandler::MakeBaseRequests(std::istream& input) {
+		auto snapshot = std::make_unique<CatalogueSnapshot>();
 
-		// первым проходом обрабатываем все остановки
-		for (int i = 0; i < 2; ++i) {
+		// запросы читаются и добавляются в базу по одному
+		MakeBaseConsumer consumer(*this, *snapshot);
+		JSONReader json_reader;
+		json_reader.Read(input, consumer);
+		consumer.Finish();
 
-			std::unordered_map<Stop*, json::Dict> um_distance_to_stops;
+		// каталог заполнен, дальше он только читается
+		snapshot->catalogue.Freeze(pool_);
 
-			for (const auto& node : arr_nodes) {
-				if (!node.IsDict()) { throw std::invalid_argument("Wrong into file structure"); }
+		snapshots_.Publish(std::move(snapshot));
+	}
 
-				const json::Dict& map_value = node.AsDict();
-				if (map_value.count("type") == 0) { throw std::invalid_argument("Wrong into file structure"); }
+	void RequestHandler::ProcessRequests(std::istream& input, std::ostream& output, const json::PrintStyle& style) {
+		json::OutputBuffer buffer(output);
+		json::Writer answers(buffer, style);
+		answers.StartArray();
+		ProcessRequestsConsumer consumer(*this, answers);
 
-				const std::string& type = map_value.at("type").AsString();
+		// запросы к траспортному каталогу отвечаются и выводятся по мере чтения
+		JSONReader json_reader;
+		json_reader.Read(input, consumer);
 
-				// обработаем остановки
-				if (i == 0 && type == "Stop") {
-					Stop* stop = CreateStop(map_value);
-					// сохраним дорожное расстояние от этой остановки до соседних.
-					if (map_value.count("road_distances")) {
-						um_distance_to_stops[stop] = map_value.at("road_distances").AsDict();
-					}
-				}
+		consumer.Finish();
+	}	
 
-				// обработаем автобусы
-				if (i == 1 && type == "Bus") {
-					CreateBus(map_value);
-				}
+	void RequestHandler::ProcessRequestLines(std::istream& input, std::ostream& output) {
 
+		using namespace std::literals;
+
+		json::OutputBuffer buffer(output);
+		// фоновая перезагрузка базы, запросы тем временем отвечаются по текущему снимку
+		std::future<void> reload;
+
+		std::string line;
+		while (std::getline(input, line)) {
+			// пустые строки пропускаются
+			if (line.find_first_not_of(" \t\r"sv) == std::string::npos) {
+				continue;
 			}
 
-			if (um_distance_to_stops.size() > 0) {
-				AddDistanceForStops(um_distance_to_stops);
+			// номер запроса, если строка разобрана и в ней есть целый id, - попадает и в ответ с ошибкой
+			std::optional<int> request_id;
+			try {
+				const json::Document doc = json::Load(std::string_view(line));
+				if (!doc.GetRoot().IsDict()) { throw std::invalid_argument("Wrong into file structure"); }
+
+				const json::Dict& request = doc.GetRoot().AsDict();
+				if (const auto it = request.find("id"s); it != request.end() && it->second.IsInt()) {
+					request_id = it->second.AsInt();
+				}
+				// строка с настройками сериализации загружает базу, ответа на нее нет
+				if (const auto it = request.find("serialization_settings"s); it != request.end()) {
+					// снимки публикуются в порядке строк, поэтому начатая перезагрузка завершается раньше
+					if (reload.valid()) { reload.get(); }
+					SetSerialization(it->second.AsDict());
+					snapshots_.Publish(LoadFromFile(serialization_.GetFileName()));
+					continue;
+				}
+				// строка reload_base перечитывает файл базы в фоне, ответа на нее тоже нет
+				if (request.count("reload_base"s)) {
+					if (reload.valid()) { reload.get(); }
+					reload = ReloadBaseAsync();
+					continue;
+				}
+
+				json::Writer writer(buffer, json::PrintStyle::COMPACT);
+				ToTransportCataloque(request, writer);
+			}
+			catch (const std::exception& e) {
+				// на каждую строку запроса должна быть строка ответа, поэтому ошибка тоже становится ответом
+				json::Writer writer(buffer, json::PrintStyle::COMPACT);
+				writer.StartDict()
+					.Key("error_message"sv).Value(e.what());
+				if (request_id) {
+					writer.Key("request_id"sv).Value(*request_id);
+				}
+				writer.EndDict();
 			}
 
+			buffer << '\n';
+			buffer.Flush();
 		}
 
+		if (reload.valid()) { reload.get(); }
 	}
 
-	json::Array RequestHandler::ToTransportCataloque(const json::Array& arr_nodes) {
-		
-		json::Array out_arr_nodes;
+	std::future<void> RequestHandler::ReloadBaseAsync() {
+		// имя файла копируется: настройки сериализации могут поменяться, пока база загружается
+		return std::async(std::launch::async, [this, file_name = serialization_.GetFileName()] {
+			snapshots_.Publish(LoadFromFile(file_name));
+		});
+	}
 
-		for (const json::Node& node : arr_nodes) {
-			if (!node.IsDict()) { throw std::invalid_argument("Wrong into file structure"); }
+	void RequestHandler::ToBase(TransportCatalogue& db, const json::ArenaDict& request, PendingBase& pending) {
 
-			const json::Dict& map_value = node.AsDict();
+		// остановка добавляется сразу, автобус и расстояния запоминаются со ссылками на остановки
+		if (request.count("type") == 0) { throw std::invalid_argument("Wrong into file structure"); }
 
-			if (map_value.count("type") == 0) { throw std::invalid_argument("Wrong into file structure"); }
-			const std::string& type = map_value.at("type").AsString();
+		const std::string_view type = request.at("type").AsString();
 
-			if (map_value.count("id") == 0) { throw std::invalid_argument("Wrong into file structure"); }
-			const int request_id = map_value.at("id").AsInt();
+		if (type == "Stop") {
+			CreateStop(db, request, pending);
+		}
+		else if (type == "Bus") {
+			CreateBus(request, pending);
+		}
 
-			std::string name;
-			if (map_value.count("name")) {
-				name = map_value.at("name").AsString();
-			}
+	}
 
-			json::Dict dict;
+	void RequestHandler::ToTransportCataloque(const json::Dict& map_value, json::Writer& writer) const {
 
-			if (type == "Stop") {
-				std::optional<std::set<std::string_view>*> stop_info = GetBusesByStop(name);
-				if (stop_info) {
-					dict = OutStopInfo(request_id, stop_info);
-				}
+		// снимок удерживается до конца ответа, даже если за это время опубликуют новый
+		const SnapshotHolder::Reader snapshot = snapshots_.Acquire();
+
+		if (map_value.count("type") == 0) { throw std::invalid_argument("Wrong into file structure"); }
+		const std::string& type = map_value.at("type").AsString();
+
+		if (map_value.count("id") == 0) { throw std::invalid_argument("Wrong into file structure"); }
+		const int request_id = map_value.at("id").AsInt();
+
+		std::string name;
+		if (map_value.count("name")) {
+			name = map_value.at("name").AsString();
+		}
+
+		// ответ выводится, только когда все поля запроса прочитаны и ответ найден
+		if (type == "Stop") {
+			std::optional<TransportCatalogue::BusesRange> stop_info = GetBusesByStop(*snapshot, name);
+			if (stop_info) {
+				OutStopInfo(writer, request_id, *stop_info);
+				return;
 			}
-			else if (type == "Bus") {
+		}
+		else if (type == "Bus") {
 
-				std::optional<BusStat> bus_info = GetBusStat(name);
-				if (bus_info) {
-					dict = OutBusInfo(request_id, bus_info);
-				}
+			std::optional<BusStat> bus_info = GetBusStat(*snapshot, name);
+			if (bus_info) {
+				OutBusInfo(writer, request_id, *bus_info);
+				return;
+			}
 
+		}
+		else if (type == "Map") {
+			OutMap(writer, *snapshot, request_id);
+			return;
+		}
+		else if (type == "Route") {
+			std::string stop_from, stop_to;
+			if (map_value.count("from")) {
+				stop_from = map_value.at("from").AsString();
 			}
-			else if (type == "Map") {
-				dict = OutMap(request_id);
+			if (map_value.count("to")) {
+				stop_to = map_value.at("to").AsString();
 			}
-			else if (type == "Route") {
-				std::string stop_from, stop_to;
-				if (map_value.count("from")) {
-					stop_from = map_value.at("from").AsString();
-				}
-				if (map_value.count("to")) {
-					stop_to = map_value.at("to").AsString();
-				}
-				dict = OutRoutInfo(request_id, stop_from, stop_to);
+			// получим данные по маршруту
+			const auto route_info = snapshot->router.GetRouteInfo(stop_from, stop_to);
+			if (route_info) {
+				OutRouteItems(writer, request_id, *route_info);
+				return;
 			}
-			/*else {
+		}
+		else if (type == "NearestStops") {
+			if (map_value.count("radius") == 0) {
 				throw std::invalid_argument("Wrong into file structure");
-			}*/
-
-			if (dict.size() == 0) {
-				dict = GetNotFoundNode(map_value.at("id").AsInt());
 			}
-
-			out_arr_nodes.push_back(dict);
+			const geo::Coordinates center = GetCoordinates(map_value);
+			size_t limit = 0;
+			if (map_value.count("limit")) {
+				limit = GetLimit(map_value);
+			}
+			OutNearestStops(writer, *snapshot, request_id, center, map_value.at("radius").AsDouble(), limit);
+			return;
 		}
+		else if (type == "Suggest") {
+			if (map_value.count("query") == 0) {
+				throw std::invalid_argument("Wrong into file structure");
+			}
+			// по умолчанию возвращаем десять подсказок
+			size_t limit = 10;
+			if (map_value.count("limit")) {
+				limit = GetLimit(map_value);
+			}
+			OutSuggest(writer, *snapshot, request_id, map_value.at("query").AsString(), limit);
+			return;
+		}
+		else if (type == "Journey") {
+			if (map_value.count("from") == 0 || map_value.count("to") == 0) {
+				throw std::invalid_argument("Wrong into file structure");
+			}
+			const geo::Coordinates from = GetCoordinates(map_value.at("from").AsDict());
+			const geo::Coordinates to = GetCoordinates(map_value.at("to").AsDict());
+			const auto route_info = snapshot->router.GetJourneyInfo(snapshot->catalogue, from, to);
+			if (route_info) {
+				OutRouteItems(writer, request_id, *route_info);
+				return;
+			}
+		}
+		/*else {
+			throw std::invalid_argument("Wrong into file structure");
+		}*/
 
-		return out_arr_nodes;
+		OutNotFound(writer, request_id);
 	}
 
-	void RequestHandler::SettingsForMap(const json::Dict& dict_node) {
+	void RequestHandler::SettingsForMap(CatalogueSnapshot& snapshot, const json::Dict& dict_node) {
 
 		renderer::MapSettings settings;
 		// распарсим и заполним настройки
@@ -251,19 +402,25 @@ namespace transport_catalog {
 
 		}
 
-		renderer_.SetSettings(settings);
+		snapshot.renderer.SetSettings(settings);
 
 	}
 
-	void RequestHandler::SetRoutingSettings(const json::Dict& dict_node) {
+	void RequestHandler::SetRoutingSettings(CatalogueSnapshot& snapshot, const json::Dict& dict_node) {
 		
 		// распарсим и заполним настройки
 		for (const auto& [key, val] : dict_node) {
 			if (key == "bus_wait_time") {
-				transport_router_.SetWaitTime(static_cast<size_t>(val.AsInt()));
+				snapshot.router.SetWaitTime(static_cast<size_t>(val.AsInt()));
 			}
 			if (key == "bus_velocity") {
-				transport_router_.SetVelocity(val.AsDouble());
+				snapshot.router.SetVelocity(val.AsDouble());
+			}
+			if (key == "pedestrian_velocity") {
+				snapshot.router.SetPedestrianVelocity(val.AsDouble());
+			}
+			if (key == "max_walk_distance") {
+				snapshot.router.SetMaxWalkDistance(val.AsDouble());
 			}
 		}
 
@@ -275,209 +432,266 @@ namespace transport_catalog {
 			if (key == "file") {
 				serialization_.SetFileName(val.AsString());
 			}
+			else if (key == "store_rendered_map") {
+				serialization_.SetStoreRenderedMap(val.AsBool());
+			}
 		}
 	}
 	
-	size_t RequestHandler::GetUniqueStops(const std::vector<Stop*>& v_stops) const {
-		
-		std::unordered_set<std::string_view> un_set_unique_stops;
-
-		for (const auto& stop : v_stops) {
-			un_set_unique_stops.emplace(stop->name);
+	geo::Coordinates RequestHandler::GetCoordinates(const json::Dict& dict_point) const {
+		if (dict_point.count("latitude") == 0 || dict_point.count("longitude") == 0) {
+			throw std::invalid_argument("Wrong into file structure");
 		}
-
-		return un_set_unique_stops.size();
-
+		const geo::Coordinates point{ dict_point.at("latitude").AsDouble(), dict_point.at("longitude").AsDouble() };
+		// по бесконечной или неопределенной координате нельзя найти ячейку сетки и посчитать расстояние
+		if (!std::isfinite(point.lat) || !std::isfinite(point.lng)) {
+			throw std::invalid_argument("Wrong into file structure");
+		}
+		return point;
 	}
 
-	double RequestHandler::GetGeoLengthOfDistance(const std::vector<Stop*>& v_stops, const bool is_roundtrip) const {
-		double dbl_result = 0;
-		// начинаем со второй остановки, т.к. нужно подсчитать сумму от первой до второй
-		for (size_t i = 0; i < v_stops.size() - 1; ++i) {
-			double dbl_dist = ComputeDistance(v_stops[i]->coordinates, v_stops[i + 1]->coordinates);
-			dbl_result += dbl_dist;
+	size_t RequestHandler::GetLimit(const json::Dict& request) const {
+		const int limit = request.at("limit").AsInt();
+		// отрицательное число после приведения к size_t означало бы "без ограничения"
+		if (limit < 0) {
+			throw std::invalid_argument("Wrong into file structure");
 		}
-
-		// если не кольцевой, сразу же учтем и обратный путь, кроме последнего отрезка
-		if (!is_roundtrip) { dbl_result *= 2; }
-
-		return dbl_result;
+		return static_cast<size_t>(limit);
 	}
 
-	double RequestHandler::GetLengthOfDistance(const std::vector<Stop*>& v_stops, const bool is_roundtrip) const {
-		double result = 0;
+	Stop* RequestHandler::CreateStop(TransportCatalogue& db, const json::ArenaDict& map_stop, PendingBase& pending) {
 
-		for (size_t i = 0; i < v_stops.size() - 1; ++i) {
-			double distance = db_.GetDistanceBetweenStops(v_stops[i], v_stops[i + 1]);
-			result += distance;
-		}
+		const double latitude = map_stop.at("latitude").AsDouble();
+		const double longitude = map_stop.at("longitude").AsDouble();
+		Stop* stop = db.AddStop(std::string(map_stop.at("name").AsString()), latitude, longitude);
 
-		// если не кольцевой, пройдем отрезки в обратную сторону (вдруг расстояние изменилось)
-		if (!is_roundtrip) { 
-			for (size_t i = 0; i < v_stops.size() - 1; ++i) {
-				double distance = db_.GetDistanceBetweenStops(v_stops[i + 1], v_stops[i]);
-				result += distance;
+		// дорожные расстояния от этой остановки до соседних добавятся, когда будут известны все остановки
+		const auto it = map_stop.find("road_distances");
+		if (it != map_stop.end()) {
+			for (const auto& [stop_name, node_dist] : it->second.AsDict()) {
+				pending.v_distances.push_back({ stop, pending.GetStopRef(stop_name), node_dist.AsInt() });
 			}
 		}
 
-		return result;
+		return stop;
 	}
 
-	
-	Stop* RequestHandler::CreateStop(const json::Dict map_stop) {
-		return db_.AddStop(map_stop.at("name").AsString(), map_stop.at("latitude").AsDouble(), map_stop.at("longitude").AsDouble());
+	void RequestHandler::CreateBus(const json::ArenaDict& map_bus, PendingBase& pending) {
+		
+		const json::ArenaArray& stops = map_bus.at("stops").AsArray();
+
+		PendingBase::Route route;
+		route.v_stops.reserve(stops.size());
+		for (const json::ArenaNode& n_stop : stops) {
+			route.v_stops.push_back(pending.GetStopRef(n_stop.AsString()));
+		}
+		route.is_roundtrip = map_bus.at("is_roundtrip").AsBool();
+		route.name = map_bus.at("name").AsString();
+
+		pending.v_routes.push_back(std::move(route));
+		
 	}
 
-	void RequestHandler::AddDistanceForStops(const std::unordered_map<transport_catalog::Stop*, json::Dict>& un_distance) {
+	void RequestHandler::ResolvePendingBase(TransportCatalogue& db, PendingBase& pending) {
 
-		for (const auto& [stop1, map_dist] : un_distance) {
+		// каждое имя ищется в каталоге один раз
+		std::vector<Stop*> v_stops(pending.um_stop_refs.size(), nullptr);
+		for (size_t ref = 0; ref < pending.dq_stop_names.size(); ++ref) {
+			v_stops[ref] = db.FindStop(pending.dq_stop_names[ref]);
+		}
 
-			for (const auto& [stop_name, node_dist] : map_dist) {
+		// расстояния до неизвестных остановок пропускаются
+		for (const PendingBase::Distance& distance : pending.v_distances) {
+			if (v_stops[distance.to] != nullptr) {
+				db.SetDistanceBetweenStops(distance.from, v_stops[distance.to], distance.distance);
+			}
+		}
 
-				Stop* stop2 = db_.FindStop(stop_name);
-				if (stop2 != nullptr) {
-					db_.SetDistanceBetweenStops(stop1, stop2, node_dist.AsInt());
-				}
+		for (PendingBase::Route& route : pending.v_routes) {
+			std::vector<Stop*> v_route_stops;
+			v_route_stops.reserve(route.v_stops.size());
 
+			for (const size_t ref : route.v_stops) {
+				if (v_stops[ref] == nullptr) { throw std::out_of_range("Unknown stop in bus route"); }
+				v_route_stops.push_back(v_stops[ref]);
 			}
 
+			db.AddBus(std::move(route.name), std::move(v_route_stops), route.is_roundtrip);
 		}
 
 	}
 
-	Bus* RequestHandler::CreateBus(const json::Dict map_bus) {
-		
-		const json::Array& stops = map_bus.at("stops").AsArray();
-		std::vector<std::string> v_stops;
-		v_stops.reserve(stops.size());
-
-		for (const json::Node& n_stop : stops) {
-			v_stops.push_back(n_stop.AsString());
+	size_t RequestHandler::PendingBase::GetStopRef(std::string_view name) {
+		const auto it = um_stop_refs.find(name);
+		if (it != um_stop_refs.end()) {
+			return it->second;
 		}
-
-		return db_.AddBus(map_bus.at("name").AsString(), v_stops, map_bus.at("is_roundtrip").AsBool());
-		
+		// номер ссылки совпадает с позицией имени в dq_stop_names, deque не перемещает сохраненные имена
+		dq_stop_names.emplace_back(name);
+		return um_stop_refs.emplace(dq_stop_names.back(), um_stop_refs.size()).first->second;
 	}
 
-	json::Dict RequestHandler::GetNotFoundNode(const int id) {
-		
+	void RequestHandler::OutNotFound(json::Writer& writer, const int id) const {
+
 		using namespace std::literals;
 
-		return json::Builder{}
-			.StartDict()
-				.Key("request_id"s).Value(id)
-				.Key("error_message"s).Value("not found"s)
-			.EndDict()
-			.Build()
-			.AsDict();
+		writer.StartDict()
+			.Key("error_message"sv).Value("not found"sv)
+			.Key("request_id"sv).Value(id)
+			.EndDict();
 	}
 
-	json::Dict RequestHandler::OutBusInfo(const int id, const std::optional<BusStat>& bus_info) {
-		
+	void RequestHandler::OutBusInfo(json::Writer& writer, const int id, const BusStat& bus_info) const {
+
 		using namespace std::literals;
 
-		return json::Builder{}
-			.StartDict()
-				.Key("request_id"s).Value(id)
-				.Key("curvature"s).Value(bus_info->curvature)
-				.Key("route_length"s).Value(bus_info->route_length)
-				.Key("stop_count"s).Value(bus_info->stop_count)
-				.Key("unique_stop_count"s).Value(bus_info->unique_stop_count)
-			.EndDict()
-			.Build()
-			.AsDict();
+		writer.StartDict()
+			.Key("curvature"sv).Value(bus_info.curvature)
+			.Key("request_id"sv).Value(id)
+			.Key("route_length"sv).Value(bus_info.route_length)
+			.Key("stop_count"sv).Value(bus_info.stop_count)
+			.Key("unique_stop_count"sv).Value(bus_info.unique_stop_count)
+			.EndDict();
 
 	}
 
-	json::Dict RequestHandler::OutStopInfo(const int id, const std::optional<std::set<std::string_view>*>& stop_info) {
-		
-		using namespace std::literals;
+	void RequestHandler::OutStopInfo(json::Writer& writer, const int id, const TransportCatalogue::BusesRange& stop_info) const {
 
-		json::Builder builder;
+		using namespace std::literals;
 
-		builder.StartDict()
-			.Key("request_id"s).Value(id)
-			.Key("buses"s).StartArray();
+		writer.StartDict()
+			.Key("buses"sv).StartArray();
 
-		for (const auto& el : *stop_info.value()) {
-			builder.Value(static_cast<std::string>(el));
+		// имена выводятся заранее экранированными в Freeze
+		for (const Bus* bus : stop_info) {
+			writer.Value(json::QuotedString{ bus->json_name });
 		}
-		
-		builder.EndArray()
+
+		writer.EndArray()
+			.Key("request_id"sv).Value(id)
 			.EndDict();
-			
-		return builder.Build().AsDict();
 	}
 
-	json::Dict RequestHandler::OutMap(const int id) {
+	void RequestHandler::OutMap(json::Writer& writer, const CatalogueSnapshot& snapshot, const int id) const {
 
 		using namespace std::literals;
 
-		json::Builder builder;
-
-		builder.StartDict()
-			.Key("request_id"s).Value(id);
-
-		// получим готовую карту
-		std::ostringstream os;
-		renderer_.RenderMap(GetAllBuses()).Render(os);
+		// карта отрисовывается один раз на снимок, дальше отдается готовая строка JSON
+		const auto map = snapshot.renderer.GetRenderedMap(snapshot.catalogue);
 
-		builder.Key("map"s).Value(os.str())
+		writer.StartDict()
+			.Key("map"sv).Value(json::QuotedString{ map->json })
+			.Key("request_id"sv).Value(id)
 			.EndDict();
-
-		return builder.Build().AsDict();
 	}
-	
-	json::Dict RequestHandler::OutRoutInfo(const int id, const std::string& stop_from, const std::string& stop_to) {
+
+	void RequestHandler::OutRouteItems(json::Writer& writer, const int id, const TransportRouter::RouteInfoResponse& route_info) const {
 		using namespace std::literals;
-		
-		// получим данные по маршруту
-		const std::optional<TransportRouter::RouteInfoResponse> route_info = transport_router_.GetRouteInfo(stop_from, stop_to);
-		
-		if (!route_info) { return json::Dict(); }
 
-		json::Builder json_bilder;
-		json_bilder.StartDict()
-			.Key("request_id"s).Value(id)
-			.Key("total_time"s).Value(route_info->total_time)
-			.Key("items"s)
+		writer.StartDict()
+			.Key("items"sv)
 				.StartArray();
-					
-		
-		for (const auto& item : route_info->items) {
-			json_bilder.StartDict();
-			
-			if (item.is_waiting) {
-				json_bilder
-					.Key("type"s).Value("Wait"s)
-					.Key("stop_name"s).Value(std::string{ item.name })
-					.Key("time"s).Value(item.weight);
+
+		for (const auto& item : route_info.items) {
+			writer.StartDict();
+
+			if (item.is_walking) {
+				// у пешего пути без остановок (сразу до цели) имени нет
+				if (!item.json_name.empty()) {
+					writer.Key("stop_name"sv).Value(json::QuotedString{ item.json_name });
+				}
+				writer
+					.Key("time"sv).Value(item.weight)
+					.Key("type"sv).Value("Walk"sv);
+			}
+			else if (item.is_waiting) {
+				writer
+					.Key("stop_name"sv).Value(json::QuotedString{ item.json_name })
+					.Key("time"sv).Value(item.weight)
+					.Key("type"sv).Value("Wait"sv);
 			}
 			else {
-				json_bilder
-					.Key("type"s).Value("Bus"s)
-					.Key("bus"s).Value(std::string{ item.name })
-					.Key("span_count"s).Value(item.span_count)
-					.Key("time"s).Value(item.weight);
+				writer
+					.Key("bus"sv).Value(json::QuotedString{ item.json_name })
+					.Key("span_count"sv).Value(item.span_count)
+					.Key("time"sv).Value(item.weight)
+					.Key("type"sv).Value("Bus"sv);
 			}
-			json_bilder.EndDict();
+			writer.EndDict();
 		}
 
-		json_bilder.EndArray()
+		writer.EndArray()
+			.Key("request_id"sv).Value(id)
+			.Key("total_time"sv).Value(route_info.total_time)
+			.EndDict();
+
+	}
+
+	void RequestHandler::OutNearestStops(json::Writer& writer, const CatalogueSnapshot& snapshot, const int id, const geo::Coordinates center, const double radius, const size_t limit) const {
+		using namespace std::literals;
+
+		writer.StartDict()
+			.Key("request_id"sv).Value(id)
+			.Key("stops"sv)
+				.StartArray();
+
+		for (const NearbyStop& found : snapshot.catalogue.FindNearestStops(center, radius, limit)) {
+			writer.StartDict()
+				.Key("distance"sv).Value(found.distance)
+				.Key("name"sv).Value(json::QuotedString{ found.stop->json_name })
+				.EndDict();
+		}
+
+		writer.EndArray()
 			.EndDict();
-			
-		return json_bilder.Build().AsDict();
-		
 	}
 
-	void RequestHandler::FillOutFromFile() {
+	void RequestHandler::OutSuggest(json::Writer& writer, const CatalogueSnapshot& snapshot, const int id, const std::string& query, const size_t limit) const {
+		using namespace std::literals;
+
+		writer.StartDict()
+			.Key("items"sv)
+				.StartArray();
+
+		for (const NameMatch& match : snapshot.catalogue.SuggestNames(query, limit)) {
+			writer.StartDict()
+				.Key("name"sv).Value(match.name)
+				.Key("type"sv).Value(match.is_bus ? "Bus"sv : "Stop"sv)
+				.EndDict();
+		}
+
+		writer.EndArray()
+			.Key("request_id"sv).Value(id)
+			.EndDict();
+	}
+
+	std::unique_ptr<CatalogueSnapshot> RequestHandler::LoadFromFile(const std::string& file_name) const {
+
+		auto snapshot = std::make_unique<CatalogueSnapshot>();
 		
-		std::ifstream infile(serialization_.GetFileName(), std::ios::binary);
+		// Deserialize не читает настройки сериализации, поэтому может выполняться в фоне
+		std::ifstream infile(file_name, std::ios::binary);
+		std::string stored_map;
 		if (infile.is_open()) {	
-			serialization_.Deserialize(infile, db_, renderer_, transport_router_);
+			stored_map = serialization_.Deserialize(infile, snapshot->catalogue, snapshot->renderer, snapshot->router);
 		}
 
 		infile.close();
+
+		// каталог заполнен, дальше он только читается
+		snapshot->catalogue.Freeze(pool_);
+		// карта из базы привязывается к поколению заполненного каталога
+		if (!stored_map.empty()) {
+			snapshot->renderer.SetRenderedMap(std::move(stored_map), snapshot->catalogue);
+		}
+
+		// граф строится один раз на снимок, карта рисуется заранее, пока строится граф
+		TaskGraph graph;
+		graph.Add([this, &snapshot] { snapshot->router.BuildGraph(snapshot->catalogue, pool_); });
+		graph.Add([&snapshot] { snapshot->renderer.GetRenderedMap(snapshot->catalogue); });
+		graph.Run(pool_);
+
+		return snapshot;
 	}
 
 
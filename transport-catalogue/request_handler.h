@@ -1,20 +1,24 @@
 #pragma once
 
 #include <optional>
-#include <unordered_set>
 #include <unordered_map>
 #include <string_view>
 #include <algorithm>
+#include <deque>
 #include <fstream>
+#include <future>
+#include <memory>
 
+#include "catalogue_snapshot.h"
 #include "domain.h"
 #include "transport_catalogue.h"
 #include "map_renderer.h"
 #include "json.h"
 #include "json_reader.h"
-#include "json_builder.h"
+#include "json_writer.h"
 #include "transport_router.h"
 #include "serialization.h"
+#include "task_pool.h"
 
 
 namespace transport_catalog {
@@ -31,64 +35,93 @@ namespace transport_catalog {
 
     class RequestHandler {
     public:
-        RequestHandler() = default;
-        RequestHandler(TransportCatalogue& db, renderer::MapRenderer& renderer, TransportRouter& transport_router, Serialization& serializtion)
-            : db_(db)
-            , renderer_(renderer)
-            , transport_router_(transport_router)
+        RequestHandler(SnapshotHolder& snapshots, Serialization& serializtion, TaskPool& pool)
+            : snapshots_(snapshots)
             , serialization_(serializtion)
+            , pool_(pool)
         {}
         
         // Возвращает информацию о маршруте (запрос Bus)
-        std::optional<BusStat> GetBusStat(const std::string_view& bus_name) const;
+        std::optional<BusStat> GetBusStat(const CatalogueSnapshot& snapshot, const std::string_view& bus_name) const;
         // Возвращает маршруты, проходящие через остановку
-        std::optional<std::set<std::string_view>*> GetBusesByStop(const std::string_view& stop_name) const;
-        // получает все маршруты хранящиеся в базе
-        const std::unordered_map<std::string_view, Bus*>& GetAllBuses() const;
+        std::optional<TransportCatalogue::BusesRange> GetBusesByStop(const CatalogueSnapshot& snapshot, const std::string_view& stop_name) const;
 
-        // заполняет транспортный каталог данными и устанавливает настройки
+        // заполняет новый снимок транспортного каталога данными, устанавливает настройки и публикует его
         void MakeBaseRequests(std::istream& input);
-        // возвращает ответы на запросы к транспортному каталогу
-        json::Document ProcessRequests(std::istream& input);
-        // обрабатывает запросы добавления в транспортный справочник
-        void ToBase(const json::Array& arr_nodes);
-        // обрабатывает запросы к транспортному справочнику и выводит готовый результат
-        json::Array ToTransportCataloque(const json::Array& arr_nodes);
+        // отвечает на запросы к транспортному каталогу по мере чтения и сразу выводит ответы в output,
+        // оформление вывода задает style
+        void ProcessRequests(std::istream& input, std::ostream& output, const json::PrintStyle& style = json::PrintStyle::PRETTY);
+        // режим JSON Lines: каждая строка input - запрос к каталогу, объект с serialization_settings,
+        // который загружает базу, или объект с ключом reload_base, который перечитывает ее в фоне (ReloadBaseAsync).
+        // На каждый запрос выводится одна строка с ответом сразу после чтения запроса
+        void ProcessRequestLines(std::istream& input, std::ostream& output);
+        // загружает базу из текущего файла в фоне и подменяет ею текущий снимок; запросы продолжают обрабатываться по старому снимку
+        std::future<void> ReloadBaseAsync();
+        // обрабатывает запрос к транспортному справочнику и выводит ответ в writer.
+        // Запрос проверяется до начала вывода, при ошибке в запросе writer остается нетронутым
+        void ToTransportCataloque(const json::Dict& request, json::Writer& writer) const;
         // обрабатывает настройки карты и передает их в модуль map_renderer
-        void SettingsForMap(const json::Dict& dict_node);
+        void SettingsForMap(CatalogueSnapshot& snapshot, const json::Dict& dict_node);
         // обрабатыает настройки маршрутизации
-        void SetRoutingSettings(const json::Dict& dict_node);
+        void SetRoutingSettings(CatalogueSnapshot& snapshot, const json::Dict& dict_node);
         // обрабатыает настройки сериализации
         void SetSerialization(const json::Dict& dict_node);
 
     private:
-        // RequestHandler использует агрегацию объектов "Транспортный Справочник", "Визуализатор Карты", "Маршрутизация транспорта"
-        TransportCatalogue& db_;
-        renderer::MapRenderer& renderer_;
-        TransportRouter& transport_router_;
+        // получатели запросов из JSONReader для make_base и process_requests
+        class MakeBaseConsumer;
+        class ProcessRequestsConsumer;
+
+        // RequestHandler отвечает по текущему снимку "Транспортного Справочника", "Визуализатора Карты" и "Маршрутизации транспорта"
+        SnapshotHolder& snapshots_;
         Serialization& serialization_;
+        TaskPool& pool_; // потоки для построения снимков
+        // возвращает координаты точки, заданной полями latitude и longitude; координаты должны быть конечными
+        geo::Coordinates GetCoordinates(const json::Dict& dict_point) const;
+        // возвращает неотрицательное поле limit запроса
+        size_t GetLimit(const json::Dict& request) const;
+
+        // Данные запросов добавления, которые ссылаются на остановки по имени.
+        // Имена заменяются номерами ссылок и разрешаются одним проходом после чтения всех остановок
+        struct PendingBase {
+            struct Distance {
+                Stop* from = nullptr;
+                size_t to = 0; // номер ссылки на остановку
+                int distance = 0;
+            };
+            struct Route {
+                std::string name;
+                std::vector<size_t> v_stops; // номера ссылок на остановки
+                bool is_roundtrip = false;
+            };
 
-        // возвращает кол-во уникальных остановок
-        size_t GetUniqueStops(const std::vector<Stop*>& v_stops) const;
-        // возвращает географическую длину маршрута
-        double GetGeoLengthOfDistance(const std::vector<Stop*>& v_stops, const bool is_roundtrip) const;
-        // возвращает фактическую длину маршрута
-        double GetLengthOfDistance(const std::vector<Stop*>& v_stops, const bool is_roundtrip) const;
+            std::deque<std::string> dq_stop_names; // имена остановок, на которые ссылается um_stop_refs
+            std::unordered_map<std::string_view, size_t> um_stop_refs; // имя остановки -> номер ссылки
+            std::vector<Distance> v_distances;
+            std::vector<Route> v_routes;
+
+            // возвращает номер ссылки на остановку, имя копируется только при первой встрече
+            size_t GetStopRef(std::string_view name);
+        };
 
         // ф-и для ввода информаци
-        Stop* CreateStop(const json::Dict map_stop);
-        void AddDistanceForStops(const std::unordered_map<transport_catalog::Stop*, json::Dict>& un_distance);
-        Bus* CreateBus(const json::Dict map_bus);
+        // обрабатывает запрос добавления в транспортный справочник
+        void ToBase(TransportCatalogue& db, const json::ArenaDict& request, PendingBase& pending);
+        Stop* CreateStop(TransportCatalogue& db, const json::ArenaDict& map_stop, PendingBase& pending);
+        void CreateBus(const json::ArenaDict& map_bus, PendingBase& pending);
+        void ResolvePendingBase(TransportCatalogue& db, PendingBase& pending);
         
-        // ф-и для вывода информации
-        json::Dict GetNotFoundNode(const int id);
-        json::Dict OutBusInfo(const int id, const std::optional<BusStat>& bus_info);
-        json::Dict OutStopInfo(const int id, const std::optional<std::set<std::string_view>*>& stop_info);
-        json::Dict OutMap(const int id);
-        json::Dict OutRoutInfo(const int id, const std::string& stop_from, const std::string& stop_to);
-
-        // заполняет данные из файла
-        void FillOutFromFile();
+        // ф-и для вывода информации, ключи ответа выводятся по алфавиту
+        void OutNotFound(json::Writer& writer, const int id) const;
+        void OutBusInfo(json::Writer& writer, const int id, const BusStat& bus_info) const;
+        void OutStopInfo(json::Writer& writer, const int id, const TransportCatalogue::BusesRange& stop_info) const;
+        void OutMap(json::Writer& writer, const CatalogueSnapshot& snapshot, const int id) const;
+        void OutRouteItems(json::Writer& writer, const int id, const TransportRouter::RouteInfoResponse& route_info) const;
+        void OutNearestStops(json::Writer& writer, const CatalogueSnapshot& snapshot, const int id, const geo::Coordinates center, const double radius, const size_t limit) const;
+        void OutSuggest(json::Writer& writer, const CatalogueSnapshot& snapshot, const int id, const std::string& query, const size_t limit) const;
+
+        // строит новый снимок по данным из файла
+        std::unique_ptr<CatalogueSnapshot> LoadFromFile(const std::string& file_name) const;
     };
 
 
@@ -21,6 +21,10 @@ private:
 
 public:
     explicit Router(const Graph& graph);
+    // parallel_for(count, fn) вызывает fn(i) для i от 0 до count в любом порядке, в том числе параллельно.
+    // На шаге через вершину строка этой вершины не меняется, поэтому остальные строки обновляются независимо
+    template <typename ParallelFor>
+    Router(const Graph& graph, ParallelFor parallel_for);
 
     struct RouteInfo {
         Weight weight;
@@ -65,11 +69,15 @@ private:
 
     void RelaxRoutesInternalDataThroughVertex(size_t vertex_count, VertexId vertex_through) {
         for (VertexId vertex_from = 0; vertex_from < vertex_count; ++vertex_from) {
-            if (const auto& route_from = routes_internal_data_[vertex_from][vertex_through]) {
-                for (VertexId vertex_to = 0; vertex_to < vertex_count; ++vertex_to) {
-                    if (const auto& route_to = routes_internal_data_[vertex_through][vertex_to]) {
-                        RelaxRoute(vertex_from, vertex_to, *route_from, *route_to);
-                    }
+            RelaxRowThroughVertex(vertex_count, vertex_from, vertex_through);
+        }
+    }
+
+    void RelaxRowThroughVertex(size_t vertex_count, VertexId vertex_from, VertexId vertex_through) {
+        if (const auto& route_from = routes_internal_data_[vertex_from][vertex_through]) {
+            for (VertexId vertex_to = 0; vertex_to < vertex_count; ++vertex_to) {
+                if (const auto& route_to = routes_internal_data_[vertex_through][vertex_to]) {
+                    RelaxRoute(vertex_from, vertex_to, *route_from, *route_to);
                 }
             }
         }
@@ -94,6 +102,25 @@ Router<Weight>::Router(const Graph& graph)
     }
 }
 
+template <typename Weight>
+template <typename ParallelFor>
+Router<Weight>::Router(const Graph& graph, ParallelFor parallel_for)
+    : graph_(graph)
+    , routes_internal_data_(graph.GetVertexCount())
+{
+    const size_t vertex_count = graph.GetVertexCount();
+    parallel_for(vertex_count, [this, vertex_count](size_t vertex) {
+        routes_internal_data_[vertex].resize(vertex_count);
+    });
+    InitializeRoutesInternalData(graph);
+
+    for (VertexId vertex_through = 0; vertex_through < vertex_count; ++vertex_through) {
+        parallel_for(vertex_count, [this, vertex_count, vertex_through](size_t vertex_from) {
+            RelaxRowThroughVertex(vertex_count, vertex_from, vertex_through);
+        });
+    }
+}
+
 template <typename Weight>
 std::optional<typename Router<Weight>::RouteInfo> Router<Weight>::BuildRoute(VertexId from,
                                                                              VertexId to) const {
@@ -1,5 +1,10 @@
 ﻿#include "serialization.h"
 
+#include <algorithm>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
 
 void Serialization::SetFileName(const std::string& name) {
     file_name_ = name;
@@ -9,46 +14,93 @@ const std::string& Serialization::GetFileName() const {
     return file_name_;
 }
 
+void Serialization::SetStoreRenderedMap(bool store) {
+    store_rendered_map_ = store;
+}
+
+bool Serialization::IsStoreRenderedMap() const {
+    return store_rendered_map_;
+}
+
 // Serialization
-void Serialization::Serialize(std::ofstream& output, const transport_catalog::TransportCatalogue& tc, const transport_catalog::renderer::MapRenderer& renderer, const transport_catalog::TransportRouter& transport_router) {
+void Serialization::Serialize(std::ofstream& output, const transport_catalog::TransportCatalogue& tc, const transport_catalog::renderer::MapRenderer& renderer, const transport_catalog::TransportRouter& transport_router, transport_catalog::TaskPool& pool) {
 
     transport_catalog_serialize::TransportCatalogue tc_serialized;
-   
+
+    // готовая карта рисуется параллельно с переводом каталога в protobuf
+    std::shared_ptr<const transport_catalog::renderer::RenderedMap> rendered_map;
+    transport_catalog::TaskGraph graph;
+    if (store_rendered_map_) {
+        graph.Add([&rendered_map, &renderer, &tc] { rendered_map = renderer.GetRenderedMap(tc); });
+    }
+    graph.Add([this, &tc, &tc_serialized] { SerializeCatalogue(tc, tc_serialized); });
+    graph.Run(pool);
+
+    // сериализуем настройки карты
+    *tc_serialized.mutable_map_settings() = std::move(SerializeMapSettings(renderer.GetSettings()));
+
+    // сохраним готовую карту
+    if (rendered_map) {
+        tc_serialized.set_rendered_map(rendered_map->svg);
+    }
+
+    // сериализуем настройки роутера
+    tc_serialized.mutable_router_settings()->set_bus_wait_time(transport_router.GetWaitTime());
+    tc_serialized.mutable_router_settings()->set_bus_velocity(transport_router.GetVelocity());
+    tc_serialized.mutable_router_settings()->set_pedestrian_velocity(transport_router.GetPedestrianVelocity());
+    tc_serialized.mutable_router_settings()->set_max_walk_distance(transport_router.GetMaxWalkDistance());
+
+    // ключи map в protobuf по умолчанию пишутся в порядке хеш-таблицы, детерминированный режим их сортирует
+    google::protobuf::io::OstreamOutputStream raw_output(&output);
+    google::protobuf::io::CodedOutputStream coded_output(&raw_output);
+    coded_output.SetSerializationDeterministic(true);
+    tc_serialized.SerializeToCodedStream(&coded_output);
+}
+
+void Serialization::SerializeCatalogue(const transport_catalog::TransportCatalogue& tc, transport_catalog_serialize::TransportCatalogue& tc_serialized) {
+
+    // Файл базы должен зависеть только от содержимого каталога: остановки идут под своими номерами,
+    // автобусы и расстояния упорядочены, а не перечисляются в порядке хеш-таблиц
+
     // сериализуем остановки
     for (const auto& [name, stop_ptr] : tc.GetAllStops()) {
         transport_catalog_serialize::Stop stop_serialized = SerializeStop(stop_ptr);
-        (*tc_serialized.mutable_stops())[reinterpret_cast<uint64_t>(stop_ptr)] = std::move(stop_serialized);
+        (*tc_serialized.mutable_stops())[stop_ptr->id] = std::move(stop_serialized);
     }
     
-    // сериализуем автобусы    
+    // сериализуем автобусы в порядке имен
+    std::vector<const transport_catalog::Bus*> v_buses;
+    v_buses.reserve(tc.GetAllBuses().size());
     for (const auto& [name, bus_ptr] : tc.GetAllBuses()) {
+        v_buses.push_back(bus_ptr);
+    }
+    std::sort(v_buses.begin(), v_buses.end(), [](const auto* lhs, const auto* rhs) { return lhs->name < rhs->name; });
+
+    for (const transport_catalog::Bus* bus_ptr : v_buses) {
         transport_catalog_serialize::Bus bus_serialized = SerializeBus(bus_ptr);
         tc_serialized.mutable_bus()->Add(std::move(bus_serialized));
         //*tc_serialized.add_bus() = std::move(bus_serialized);
     }
     
-    // сериализуем расстояния между остановками
-    for (const auto& [pair_stops, distance] : tc.GetAllDistance()) {
+    // сериализуем расстояния между остановками в порядке номеров остановок
+    using DistanceItem = std::pair<std::pair<transport_catalog::Stop*, transport_catalog::Stop*>, double>;
+    std::vector<DistanceItem> v_distances(tc.GetAllDistance().begin(), tc.GetAllDistance().end());
+    std::sort(v_distances.begin(), v_distances.end(), [](const DistanceItem& lhs, const DistanceItem& rhs) {
+        return std::pair{ lhs.first.first->id, lhs.first.second->id } < std::pair{ rhs.first.first->id, rhs.first.second->id };
+    });
+
+    for (const auto& [pair_stops, distance] : v_distances) {
         transport_catalog_serialize::Distance dist_serialiezed = SerializeDistance(pair_stops, distance);
         tc_serialized.mutable_distance()->Add(std::move(dist_serialiezed));
         //*tc_serialized.add_distance() = std::move(dist_serialiezed);
     }
-    
-    // сериализуем настройки карты
-    *tc_serialized.mutable_map_settings() = std::move(SerializeMapSettings(renderer.GetSettings()));
-
-    // сериализуем настройки роутера
-    tc_serialized.mutable_router_settings()->set_bus_wait_time(transport_router.GetWaitTime());
-    tc_serialized.mutable_router_settings()->set_bus_velocity(transport_router.GetVelocity());
-
-    tc_serialized.SerializeToOstream(&output);
 }
 
 transport_catalog_serialize::Stop Serialization::SerializeStop(const transport_catalog::Stop* stop_ptr) {
 
     transport_catalog_serialize::Stop stop_serialized;
 
-    stop_serialized.set_name(stop_ptr->name);
+    stop_serialized.set_name(stop_ptr->name.data(), stop_ptr->name.size());
     stop_serialized.mutable_coordinates()->set_latitude(stop_ptr->coordinates.lat);
     stop_serialized.mutable_coordinates()->set_longitude(stop_ptr->coordinates.lng);
 
@@ -59,10 +111,10 @@ transport_catalog_serialize::Bus Serialization::SerializeBus(const transport_cat
 
     transport_catalog_serialize::Bus bus_serialized;
 
-    bus_serialized.set_name(bus_ptr->name);
+    bus_serialized.set_name(bus_ptr->name.data(), bus_ptr->name.size());
     bus_serialized.set_is_roundtrip(bus_ptr->is_roundtrip);
     for (const auto& stop : bus_ptr->stops) {
-        bus_serialized.add_stop_id(reinterpret_cast<uint64_t>(stop));
+        bus_serialized.add_stop_id(stop->id);
     }
 
     return bus_serialized;
@@ -72,8 +124,8 @@ transport_catalog_serialize::Distance Serialization::SerializeDistance(const std
 
     transport_catalog_serialize::Distance dist_serialized;
 
-    dist_serialized.set_stop_id_from(reinterpret_cast<uint64_t>(p_stops.first));
-    dist_serialized.set_stop_id_to(reinterpret_cast<uint64_t>(p_stops.second));
+    dist_serialized.set_stop_id_from(p_stops.first->id);
+    dist_serialized.set_stop_id_to(p_stops.second->id);
     dist_serialized.set_distance(distance);
 
     return dist_serialized;
@@ -144,16 +196,23 @@ transport_catalog_serialize::Color Serialization::SerializeColor(const svg::Colo
 
 
 // Deserialization
-void Serialization::Deserialize(std::ifstream& input, transport_catalog::TransportCatalogue& tc, transport_catalog::renderer::MapRenderer& renderer, transport_catalog::TransportRouter& transport_router) {
+std::string Serialization::Deserialize(std::ifstream& input, transport_catalog::TransportCatalogue& tc, transport_catalog::renderer::MapRenderer& renderer, transport_catalog::TransportRouter& transport_router) {
 
     transport_catalog_serialize::TransportCatalogue tc_serialized;
     if (!tc_serialized.ParseFromIstream(&input)) {
-        return;
+        return {};
     }
 
-    // десериализуем остановки
+    // десериализуем остановки в порядке номеров, чтобы номера в каталоге совпали с сохраненными
+    std::vector<uint64_t> v_stop_ids;
+    v_stop_ids.reserve(tc_serialized.stops().size());
     for (const auto& [stop_id, stop] : tc_serialized.stops()) {
-        DeserializeStop(stop, tc);
+        v_stop_ids.push_back(stop_id);
+    }
+    std::sort(v_stop_ids.begin(), v_stop_ids.end());
+
+    for (const uint64_t stop_id : v_stop_ids) {
+        DeserializeStop(tc_serialized.stops().at(stop_id), tc);
     }
     
     // десериализуем автобусы
@@ -175,6 +234,16 @@ void Serialization::Deserialize(std::ifstream& input, transport_catalog::Transpo
     // десериализуем настройки TransportRouter
     transport_router.SetWaitTime(tc_serialized.router_settings().bus_wait_time());
     transport_router.SetVelocity(tc_serialized.router_settings().bus_velocity());
+    // в базах, сохраненных до появления пеших участков, этих настроек нет - остаются значения по умолчанию
+    if (tc_serialized.router_settings().has_pedestrian_velocity()) {
+        transport_router.SetPedestrianVelocity(tc_serialized.router_settings().pedestrian_velocity());
+    }
+    if (tc_serialized.router_settings().has_max_walk_distance()) {
+        transport_router.SetMaxWalkDistance(tc_serialized.router_settings().max_walk_distance());
+    }
+
+    // карта, сохраненная в базе, отдается без отрисовки, когда каталог будет заполнен
+    return std::move(*tc_serialized.mutable_rendered_map());
 }
 
 void Serialization::DeserializeStop(const transport_catalog_serialize::Stop& stop, transport_catalog::TransportCatalogue& tc) {
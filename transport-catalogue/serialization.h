@@ -4,6 +4,7 @@
 #include "transport_catalogue.h"
 #include "map_renderer.h"
 #include "svg.h"
+#include "task_pool.h"
 #include "transport_router.h"
 
 #include <transport_catalogue.pb.h>
@@ -15,15 +16,21 @@ public:
 
 	void SetFileName(const std::string& name);
 	const std::string& GetFileName() const;
-	// Сериализуем траспортный каталог
-	void Serialize(std::ofstream& output, const transport_catalog::TransportCatalogue& tc, const transport_catalog::renderer::MapRenderer& renderer, const transport_catalog::TransportRouter& transport_router);
-	// Десериализуем и заполним транспортный каталог
-	void Deserialize(std::ifstream& input, transport_catalog::TransportCatalogue& tc, transport_catalog::renderer::MapRenderer& renderer, transport_catalog::TransportRouter& transport_router);
+	// сохранять ли в базу отрисованную карту, чтобы process_requests не рисовал ее заново
+	void SetStoreRenderedMap(bool store);
+	bool IsStoreRenderedMap() const;
+	// Сериализуем траспортный каталог, карта для базы рисуется на потоках пула
+	void Serialize(std::ofstream& output, const transport_catalog::TransportCatalogue& tc, const transport_catalog::renderer::MapRenderer& renderer, const transport_catalog::TransportRouter& transport_router, transport_catalog::TaskPool& pool);
+	// Десериализуем и заполним транспортный каталог. Возвращает карту, сохраненную в базе, или пустую строку:
+	// карта привязывается к каталогу через MapRenderer::SetRenderedMap после Freeze
+	std::string Deserialize(std::ifstream& input, transport_catalog::TransportCatalogue& tc, transport_catalog::renderer::MapRenderer& renderer, transport_catalog::TransportRouter& transport_router);
 
 private:
 	std::string file_name_;
+	bool store_rendered_map_ = false;
 
 	// Serialize
+	void SerializeCatalogue(const transport_catalog::TransportCatalogue& tc, transport_catalog_serialize::TransportCatalogue& tc_serialized);
 	transport_catalog_serialize::Stop SerializeStop(const transport_catalog::Stop* stop_ptr);
 	transport_catalog_serialize::Bus SerializeBus(const transport_catalog::Bus* bus_ptr);
 	transport_catalog_serialize::Distance SerializeDistance(const std::pair<transport_catalog::Stop*, transport_catalog::Stop*> p_stops, double distance);
@@ -0,0 +1,144 @@
+#define _USE_MATH_DEFINES
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace transport_catalog {
+
+    void StopsGrid::Build(const std::deque<Stop>& stops, const std::vector<geo::PreparedCoordinates>& v_points) {
+
+        v_cell_stops_.clear();
+        v_cell_points_.clear();
+        v_cell_offsets_.clear();
+        rows_ = 0;
+        cols_ = 0;
+
+        if (stops.empty()) {
+            return;
+        }
+
+        // границы области, занятой остановками
+        const auto [bottom_it, top_it] = std::minmax_element(stops.begin(), stops.end(),
+            [](const Stop& lhs, const Stop& rhs) { return lhs.coordinates.lat < rhs.coordinates.lat; });
+        const auto [left_it, right_it] = std::minmax_element(stops.begin(), stops.end(),
+            [](const Stop& lhs, const Stop& rhs) { return lhs.coordinates.lng < rhs.coordinates.lng; });
+
+        min_lat_ = bottom_it->coordinates.lat;
+        min_lng_ = left_it->coordinates.lng;
+
+        // в среднем по две остановки на ячейку
+        const size_t side = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(stops.size() / 2.))));
+        rows_ = side;
+        cols_ = side;
+
+        cell_lat_ = (top_it->coordinates.lat - min_lat_) / rows_;
+        cell_lng_ = (right_it->coordinates.lng - min_lng_) / cols_;
+        // все остановки на одной широте (долготе) - хватит одной ячейки любого размера
+        if (cell_lat_ <= 0.) { cell_lat_ = 1.; }
+        if (cell_lng_ <= 0.) { cell_lng_ = 1.; }
+
+        auto get_cell = [this](const Stop& stop) {
+            return GetRow(stop.coordinates.lat) * cols_ + GetCol(stop.coordinates.lng);
+        };
+
+        // первым проходом считаем количество остановок в ячейках
+        v_cell_offsets_.assign(rows_ * cols_ + 1, 0);
+        for (const Stop& stop : stops) {
+            ++v_cell_offsets_[get_cell(stop) + 1];
+        }
+
+        for (size_t i = 1; i < v_cell_offsets_.size(); ++i) {
+            v_cell_offsets_[i] += v_cell_offsets_[i - 1];
+        }
+
+        // вторым проходом раскладываем остановки по ячейкам
+        v_cell_stops_.assign(stops.size(), nullptr);
+        v_cell_points_.resize(stops.size());
+        std::vector<size_t> v_positions(v_cell_offsets_.begin(), v_cell_offsets_.end() - 1);
+        for (const Stop& stop : stops) {
+            const size_t pos = v_positions[get_cell(stop)]++;
+            v_cell_stops_[pos] = &stop;
+            v_cell_points_[pos] = v_points[stop.id];
+        }
+
+    }
+
+    std::vector<NearbyStop> StopsGrid::FindNearest(geo::Coordinates center, double radius, size_t limit) const {
+
+        std::vector<NearbyStop> result;
+
+        if (rows_ == 0 || !(radius >= 0.) || !std::isfinite(center.lat) || !std::isfinite(center.lng)) {
+            return result;
+        }
+
+        static const double dr = M_PI / 180.;
+        static const double METERS_IN_DEGREE = geo::EARTH_RADIUS * dr;
+
+        // прямоугольник в градусах, в который гарантированно попадает круг поиска
+        const double delta_lat = radius / METERS_IN_DEGREE;
+        const size_t row_from = GetRow(center.lat - delta_lat);
+        const size_t row_to = GetRow(center.lat + delta_lat);
+
+        size_t col_from = 0;
+        size_t col_to = cols_ - 1;
+        // градус долготы короче всего у самой удаленной от экватора границы полосы
+        const double max_abs_lat = std::abs(center.lat) + delta_lat;
+        if (max_abs_lat < 90.) {
+            const double delta_lng = delta_lat / std::cos(max_abs_lat * dr);
+            col_from = GetCol(center.lng - delta_lng);
+            col_to = GetCol(center.lng + delta_lng);
+        }
+
+        const geo::PreparedCoordinates prepared_center = geo::PrepareCoordinates(center);
+        // расстояния до остановок строки сетки, буфер переиспользуется между вызовами
+        thread_local std::vector<double> v_distances;
+
+        for (size_t row = row_from; row <= row_to; ++row) {
+            // ячейки одной строки лежат в массивах подряд, поэтому расстояния считаются одним вызовом
+            const size_t first = v_cell_offsets_[row * cols_ + col_from];
+            const size_t last = v_cell_offsets_[row * cols_ + col_to + 1];
+
+            v_distances.resize(last - first);
+            geo::ComputeDistances(prepared_center, v_cell_points_.data() + first, last - first, v_distances.data());
+
+            for (size_t i = first; i < last; ++i) {
+                const double distance = v_distances[i - first];
+                if (distance <= radius) {
+                    result.push_back({ v_cell_stops_[i], distance });
+                }
+            }
+        }
+
+        // при равных расстояниях порядок определяется именем, чтобы ответ не зависел от раскладки по ячейкам
+        auto is_closer = [](const NearbyStop& lhs, const NearbyStop& rhs) {
+            return lhs.distance < rhs.distance || (lhs.distance == rhs.distance && lhs.stop->name < rhs.stop->name);
+        };
+
+        if (limit != 0 && limit < result.size()) {
+            std::partial_sort(result.begin(), result.begin() + limit, result.end(), is_closer);
+            result.resize(limit);
+        }
+        else {
+            std::sort(result.begin(), result.end(), is_closer);
+        }
+
+        return result;
+    }
+
+    size_t StopsGrid::GetRow(double lat) const {
+        // NaN тоже попадает в первую строку, его нельзя приводить к size_t
+        if (!(lat > min_lat_)) {
+            return 0;
+        }
+        return static_cast<size_t>(std::min((lat - min_lat_) / cell_lat_, static_cast<double>(rows_ - 1)));
+    }
+
+    size_t StopsGrid::GetCol(double lng) const {
+        if (!(lng > min_lng_)) {
+            return 0;
+        }
+        return static_cast<size_t>(std::min((lng - min_lng_) / cell_lng_, static_cast<double>(cols_ - 1)));
+    }
+
+}   // namespace transport_catalog
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "domain.h"
+#include "geo.h"
+
+namespace transport_catalog {
+
+    // найденная рядом с точкой остановка
+    struct NearbyStop {
+        const Stop* stop = nullptr;
+        double distance = 0.; // расстояние до точки в метрах
+    };
+
+    // Равномерная сетка по координатам остановок.
+    // Строится один раз по заполненному каталогу, дальше только читается
+    class StopsGrid {
+    public:
+        StopsGrid() = default;
+
+        // раскладывает остановки по ячейкам сетки.
+        // v_points - подготовленные координаты остановок по номеру остановки
+        void Build(const std::deque<Stop>& stops, const std::vector<geo::PreparedCoordinates>& v_points);
+        // возвращает не более limit остановок в радиусе radius метров от точки, ближние первыми.
+        // limit == 0 - без ограничения количества. Для точки с бесконечной или неопределенной координатой список пуст
+        std::vector<NearbyStop> FindNearest(geo::Coordinates center, double radius, size_t limit) const;
+
+    private:
+        double min_lat_ = 0.;
+        double min_lng_ = 0.;
+        double cell_lat_ = 1.; // размер ячейки по широте в градусах
+        double cell_lng_ = 1.; // размер ячейки по долготе в градусах
+        size_t rows_ = 0;
+        size_t cols_ = 0;
+
+        std::vector<const Stop*> v_cell_stops_; // остановки всех ячеек подряд
+        std::vector<geo::PreparedCoordinates> v_cell_points_; // координаты остановок в том же порядке, что v_cell_stops_
+        std::vector<size_t> v_cell_offsets_;    // начало ячейки в v_cell_stops_ (размер - число ячеек + 1)
+
+        // возвращает номер строки/столбца, ограниченный размерами сетки
+        size_t GetRow(double lat) const;
+        size_t GetCol(double lng) const;
+    };
+
+}   // namespace transport_catalog
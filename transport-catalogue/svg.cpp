@@ -1,29 +1,88 @@
 #include "svg.h"
 
+#include <charconv>
+#include <iterator>
+
 namespace svg {
 
 using namespace std::literals;
 
-void Object::Render(const RenderContext& context) const {
-    context.RenderIndent();
+// ---------- OutputBuffer ------------------
 
-    // Делегируем вывод тега своим подклассам
-    RenderObject(context);
+OutputBuffer& OutputBuffer::operator<<(std::string_view text) {
+    output_.append(text);
+    return *this;
+}
 
-    context.out << std::endl;
+OutputBuffer& OutputBuffer::operator<<(const std::string& text) {
+    return *this << std::string_view(text);
 }
- 
-void OstreamColorPrinter::operator()(std::monostate) {
-    os << "none"sv;
+
+OutputBuffer& OutputBuffer::operator<<(char ch) {
+    output_.push_back(ch);
+    return *this;
 }
-void OstreamColorPrinter::operator()(std::string str) {
-    os << str;
+
+OutputBuffer& OutputBuffer::operator<<(uint32_t value) {
+    char chars[16];
+    const auto [ptr, ec] = std::to_chars(std::begin(chars), std::end(chars), value);
+    return *this << std::string_view(chars, ptr - chars);
 }
-void OstreamColorPrinter::operator()(svg::Rgb rgb) {
-    os << "rgb("sv << std::to_string(rgb.red) << ","sv << std::to_string(rgb.green) << ","sv << std::to_string(rgb.blue) << ")"sv;
+
+OutputBuffer& OutputBuffer::operator<<(double value) {
+    // поток с настройками по умолчанию выводит double как printf("%.6g"),
+    // to_chars в формате general с точностью 6 дает тот же результат
+    char chars[32];
+    const auto [ptr, ec] = std::to_chars(std::begin(chars), std::end(chars), value, std::chars_format::general, 6);
+    return *this << std::string_view(chars, ptr - chars);
 }
-void OstreamColorPrinter::operator()(svg::Rgba rgba) {
-    os << "rgba("sv << std::to_string(rgba.red) << ","sv << std::to_string(rgba.green) << ","sv << std::to_string(rgba.blue) << ","sv << rgba.opacity << ")"sv;
+
+OutputBuffer& OutputBuffer::operator<<(const Color& color) {
+    if (const auto* str = std::get_if<std::string>(&color)) {
+        *this << *str;
+    }
+    else if (const auto* rgb = std::get_if<Rgb>(&color)) {
+        *this << "rgb("sv << uint32_t{ rgb->red } << ","sv << uint32_t{ rgb->green } << ","sv << uint32_t{ rgb->blue } << ")"sv;
+    }
+    else if (const auto* rgba = std::get_if<Rgba>(&color)) {
+        *this << "rgba("sv << uint32_t{ rgba->red } << ","sv << uint32_t{ rgba->green } << ","sv << uint32_t{ rgba->blue } << ","sv << rgba->opacity << ")"sv;
+    }
+    else {
+        *this << "none"sv;
+    }
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(StrokeLineCap line_cap) {
+
+    switch (line_cap) {
+    case StrokeLineCap::BUTT:
+        return *this << "butt"sv;
+    case StrokeLineCap::ROUND:
+        return *this << "round"sv;
+    case StrokeLineCap::SQUARE:
+        return *this << "square"sv;
+    }
+
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(StrokeLineJoin line_join) {
+
+    switch (line_join) {
+    case StrokeLineJoin::ARCS:
+        return *this << "arcs"sv;
+    case StrokeLineJoin::BEVEL:
+        return *this << "bevel"sv;
+    case StrokeLineJoin::MITER:
+        return *this << "miter"sv;
+    case StrokeLineJoin::MITER_CLIP:
+        return *this << "miter-clip"sv;
+    case StrokeLineJoin::ROUND:
+        return *this << "round"sv;
+    }
+
+    return *this;
 }
 
 
@@ -39,12 +98,11 @@ Circle& Circle::SetRadius(double radius)  {
     return *this;
 }
 
-void Circle::RenderObject(const RenderContext& context) const {
-    auto& out = context.out;
+void Circle::Render(OutputBuffer& out) const {
     out << "<circle cx=\""sv << center_.x << "\" cy=\""sv << center_.y << "\" "sv;
     out << "r=\""sv << radius_ << "\""sv;
     // Выводим атрибуты, унаследованные от PathProps
-    RenderAttrs(context.out);
+    RenderAttrs(out);
     out << "/>"sv;
 }
 
@@ -54,20 +112,19 @@ Polyline& Polyline::AddPoint(Point point) {
     return *this;
 }
 
-void Polyline::RenderObject(const RenderContext& context) const {
-    auto& out = context.out;
+void Polyline::Render(OutputBuffer& out) const {
     out << "<polyline points=\""sv;
     bool is_first = true;
-    
+
     for (const Point& p : points_) {
         if (!is_first) { out << " "sv; }
         out << p.x << ","sv << p.y;
         if (is_first) { is_first = false; }
     }
-    
+
     out << "\""sv;
     // Выводим атрибуты, унаследованные от PathProps
-    RenderAttrs(context.out);
+    RenderAttrs(out);
     out << "/>"sv;
 }
 
@@ -102,14 +159,12 @@ Text& Text::SetData(std::string data) {
     return *this;
 }
 
-void Text::RenderObject(const RenderContext& context) const {
+void Text::Render(OutputBuffer& out) const {
     //font: [font - style || font - variant || font - weight] font - size[/ line - height] font - family | inherit
-    
-    auto& out = context.out;
-    
+
     out << "<text"sv;
     // Выводим атрибуты, унаследованные от PathProps
-    RenderAttrs(context.out);
+    RenderAttrs(out);
     out << " x=\""sv << pos_.x << "\" y=\""sv << pos_.y << "\" "sv;
     out << "dx=\""sv << offset_.x << "\" dy=\""sv << offset_.y << "\" "sv;
     out << "font-size=\""sv << font_size_ << "\""sv;
@@ -125,65 +180,29 @@ void Text::RenderObject(const RenderContext& context) const {
 }
 
 // ---------- Document ------------------
-void Document::AddPtr(std::unique_ptr<Object>&& obj) {
-    objects_.emplace_back(std::move(obj));
-}
-
-void Document::Render(std::ostream& out) const {
-    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>"sv << std::endl;
-    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">"sv << std::endl;
-
-    for (auto& ptr_obj : objects_) {
-        RenderContext ctx(out, 2, 2);
-        ptr_obj->Render(ctx);
-    }
-    
-    out << "</svg>"sv;
-}
-
-// ---------- operator<< ------------------
-
-std::ostream& operator<<(std::ostream& os, const StrokeLineCap& str_linecap) {
-
-    switch (str_linecap) {
-    case StrokeLineCap::BUTT:
-        os << "butt";
-        break;
-    case StrokeLineCap::ROUND:
-        os << "round";
-        break;
-    case StrokeLineCap::SQUARE:
-        os << "square";
-        break;
+void Document::Render(std::string& out) const {
+    // примерный размер одного тега, чтобы строка не перевыделялась по ходу вывода
+    constexpr size_t OBJECT_SIZE_HINT = 160;
+    out.reserve(out.size() + (objects_.size() + 1) * OBJECT_SIZE_HINT);
+
+    OutputBuffer buffer(out);
+    buffer << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"sv;
+    buffer << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">\n"sv;
+
+    for (const Object& obj : objects_) {
+        // каждый тег с новой строки с отступом в два пробела
+        buffer << "  "sv;
+        std::visit([&buffer](const auto& tag) { tag.Render(buffer); }, obj);
+        buffer << '\n';
     }
 
-    return os;
-}
-
-std::ostream& operator<<(std::ostream& os, const StrokeLineJoin& str_linejoin) {
-    switch (str_linejoin) {
-    case StrokeLineJoin::ARCS:
-        os << "arcs";
-        break;
-    case StrokeLineJoin::BEVEL:
-        os << "bevel";
-        break;
-    case StrokeLineJoin::MITER:
-        os << "miter";
-        break;
-    case StrokeLineJoin::MITER_CLIP:
-        os << "miter-clip";
-        break;
-    case StrokeLineJoin::ROUND:
-        os << "round";
-        break;
-    }
-    return os;
+    buffer << "</svg>"sv;
 }
 
-std::ostream& operator<<(std::ostream& os, const Color& color) {
-    std::visit(svg::OstreamColorPrinter{ os }, color);
-    return os;
+void Document::Render(std::ostream& out) const {
+    std::string text;
+    Render(text);
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
 }
 
 
@@ -2,8 +2,8 @@
 
 #include <cstdint>
 #include <iostream>
-#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include <variant>
@@ -38,17 +38,6 @@ struct Rgba {
     double opacity = 1.0;
 };
 
-struct OstreamColorPrinter {
-
-    std::ostream& os;
-
-    void operator()(std::monostate);
-    void operator()(std::string str);
-    void operator()(svg::Rgb rgb);
-    void operator()(svg::Rgba rgba);
-
-};
-
 inline const std::string NoneColor{ "none" };
 using Color = std::variant<std::monostate, std::string, svg::Rgb, svg::Rgba>;
 
@@ -77,57 +66,30 @@ struct Point {
 };
 
 
-std::ostream& operator<<(std::ostream& os, const StrokeLineCap& str_linecap);
-
-std::ostream& operator<<(std::ostream& os, const StrokeLineJoin& str_linejoin);
-
-std::ostream& operator<<(std::ostream& os, const Color& color);
-
 /*
- * Вспомогательная структура, хранящая контекст для вывода SVG-документа с отступами.
- * Хранит ссылку на поток вывода, текущее значение и шаг отступа при выводе элемента
+ * Буфер вывода SVG-документа. Текст дописывается в строку без промежуточного потока,
+ * числа форматируются через std::to_chars так же, как их выводит std::ostream с настройками по умолчанию
  */
-struct RenderContext {
-    RenderContext(std::ostream& out)
-        : out(out) {
-    }
-
-    RenderContext(std::ostream& out, int indent_step, int indent = 0)
-        : out(out)
-        , indent_step(indent_step)
-        , indent(indent) {
-    }
-
-    RenderContext Indented() const {
-        return {out, indent_step, indent + indent_step};
-    }
-
-    void RenderIndent() const {
-        for (int i = 0; i < indent; ++i) {
-            out.put(' ');
-        }
-    }
-
-    std::ostream& out;
-    int indent_step = 0;
-    int indent = 0;
-};
-
-/*
- * Абстрактный базовый класс Object служит для унифицированного хранения
- * конкретных тегов SVG-документа
- * Реализует паттерн "Шаблонный метод" для вывода содержимого тега
- */
-class Object {
+class OutputBuffer {
 public:
-    void Render(const RenderContext& context) const;
+    explicit OutputBuffer(std::string& output)
+        : output_(output) {
+    }
 
-    virtual ~Object() = default;
+    OutputBuffer& operator<<(std::string_view text);
+    // std::string приводится и к std::string_view, и к Color, поэтому выводится отдельно
+    OutputBuffer& operator<<(const std::string& text);
+    OutputBuffer& operator<<(char ch);
+    OutputBuffer& operator<<(uint32_t value);
+    OutputBuffer& operator<<(double value);
+    OutputBuffer& operator<<(const Color& color);
+    OutputBuffer& operator<<(StrokeLineCap line_cap);
+    OutputBuffer& operator<<(StrokeLineJoin line_join);
 
 private:
-    virtual void RenderObject(const RenderContext& context) const = 0;
+    std::string& output_;
 };
-    
+
 template <typename Owner>
 class PathProps {
 public:
@@ -161,7 +123,7 @@ public:
 protected:
     ~PathProps() = default;
    
-    void RenderAttrs(std::ostream& out) const {
+    void RenderAttrs(OutputBuffer& out) const {
     using namespace std::literals;
 
     if (fill_color_) {
@@ -195,38 +157,19 @@ private:
     std::optional<StrokeLineJoin> stroke_linejoin_;
 };
     
-// Интерфейс ObjectContainer задает интерфей для доступа к контейнеру SVG-объектов
-class ObjectContainer {
-public:
-    template <typename Obj>
-    void Add(Obj obj);
-
-    // Добавляет в svg-документ объект-наследник svg::Object
-    virtual void AddPtr(std::unique_ptr<Object>&& obj) = 0;
-
-protected:
-    ~ObjectContainer() = default;
-};
-
-// Интерфейс Drawable задаёт объекты, которые можно нарисовать с помощью Graphics
-class Drawable {
-public:
-    virtual void Draw(ObjectContainer& container) const = 0;
-    virtual ~Drawable() = default;
-
-};
-
 /*
  * Класс Circle моделирует элемент <circle> для отображения круга
  * https://developer.mozilla.org/en-US/docs/Web/SVG/Element/circle
  */
-class Circle final : public Object, public PathProps<Circle> {
+class Circle final : public PathProps<Circle> {
 public:
     Circle& SetCenter(Point center);
     Circle& SetRadius(double radius);
 
+    // Выводит тег без отступа и перевода строки
+    void Render(OutputBuffer& out) const;
+
 private:
-    void RenderObject(const RenderContext& context) const override;
 
     Point center_;
     double radius_ = 1.0;
@@ -236,13 +179,15 @@ private:
  * Класс Polyline моделирует элемент <polyline> для отображения ломаных линий
  * https://developer.mozilla.org/en-US/docs/Web/SVG/Element/polyline
  */
-class Polyline : public Object, public PathProps<Polyline> {
+class Polyline final : public PathProps<Polyline> {
 public:
     // Добавляет очередную вершину к ломаной линии
     Polyline& AddPoint(Point point);
 
+    // Выводит тег без отступа и перевода строки
+    void Render(OutputBuffer& out) const;
+
 private:
-    void RenderObject(const RenderContext& context) const override;
 
     std::vector<Point> points_;
 };
@@ -251,7 +196,7 @@ private:
  * Класс Text моделирует элемент <text> для отображения текста
  * https://developer.mozilla.org/en-US/docs/Web/SVG/Element/text
  */
-class Text : public Object, public PathProps<Text> {
+class Text final : public PathProps<Text> {
 public:
     // Задаёт координаты опорной точки (атрибуты x и y)
     Text& SetPosition(Point pos);
@@ -271,8 +216,10 @@ public:
     // Задаёт текстовое содержимое объекта (отображается внутри тега text)
     Text& SetData(std::string data);
 
+    // Выводит тег без отступа и перевода строки
+    void Render(OutputBuffer& out) const;
+
 private:
-    void RenderObject(const RenderContext& context) const override;
 
     Point pos_;
     Point offset_;
@@ -283,23 +230,29 @@ private:
   
 };
 
-class Document : public ObjectContainer {
+// Элемент документа. Объекты хранятся по значению в одном массиве и выводятся без виртуальных вызовов
+using Object = std::variant<Circle, Polyline, Text>;
+
+class Document {
 public:
     Document() = default;
 
-    // Добавляет в svg-документ объект-наследник svg::Object
-    void AddPtr(std::unique_ptr<Object>&& obj);
+    // Добавляет в svg-документ круг, ломаную или текст
+    template <typename Obj>
+    void Add(Obj obj);
 
+    // Дописывает svg-представление документа в строку
+    void Render(std::string& out) const;
     // Выводит в ostream svg-представление документа
     void Render(std::ostream& out) const;
 
-private:    
-    std::vector<std::unique_ptr<Object>> objects_{};
+private:
+    std::vector<Object> objects_{};
 };
 
 template <typename Obj>
-void ObjectContainer::Add(Obj obj) {
-    AddPtr(std::make_unique<Obj>(std::move(obj)));
+void Document::Add(Obj obj) {
+    objects_.emplace_back(std::move(obj));
 }
 
 
@@ -0,0 +1,261 @@
+#include "task_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace transport_catalog {
+
+    namespace {
+
+        // Общее состояние одного вызова ParallelFor. Диапазон делится на куски,
+        // потоки разбирают их по атомарному счетчику, пока куски не кончатся
+        struct ParallelForState {
+            const std::function<void(size_t)>* fn = nullptr; // действителен, пока есть незавершенные куски
+            size_t count = 0;
+            size_t chunk_size = 0;
+            size_t chunk_count = 0;
+            std::atomic<size_t> next_chunk{ 0 };
+
+            std::mutex mutex;
+            std::condition_variable all_done;
+            size_t done_chunks = 0;
+            std::exception_ptr error;
+
+            void RunChunks() {
+                for (size_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++) {
+                    const size_t begin = chunk * chunk_size;
+                    const size_t end = std::min(count, begin + chunk_size);
+                    std::exception_ptr chunk_error;
+                    try {
+                        for (size_t i = begin; i < end; ++i) {
+                            (*fn)(i);
+                        }
+                    }
+                    catch (...) {
+                        chunk_error = std::current_exception();
+                    }
+
+                    std::lock_guard lock(mutex);
+                    if (chunk_error && !error) {
+                        error = chunk_error;
+                    }
+                    if (++done_chunks == chunk_count) {
+                        all_done.notify_all();
+                    }
+                }
+            }
+        };
+
+        // Один запуск TaskGraph: готовые к запуску задачи и число незавершенных зависимостей у остальных.
+        // Помощники в пуле держат запуск живым, пока не разберут очередь готовых задач
+        template <typename Node>
+        class GraphRun : public std::enable_shared_from_this<GraphRun<Node>> {
+        public:
+            GraphRun(std::vector<Node>& v_nodes, TaskPool& pool)
+                : v_nodes_(v_nodes)
+                , pool_(pool)
+            {
+                v_waiting_.reserve(v_nodes_.size());
+                for (size_t id = 0; id < v_nodes_.size(); ++id) {
+                    v_waiting_.push_back(v_nodes_[id].dependency_count);
+                    if (v_nodes_[id].dependency_count == 0) {
+                        dq_ready_.push_back(id);
+                    }
+                }
+            }
+
+            // вызывающий поток разбирает готовые задачи, пока не будут выполнены все
+            void Run() {
+                std::unique_lock lock(mutex_);
+                SubmitHelpers(dq_ready_.size() - std::min<size_t>(dq_ready_.size(), 1));
+
+                while (true) {
+                    changed_.wait(lock, [this] { return done_count_ == v_nodes_.size() || !dq_ready_.empty(); });
+                    if (done_count_ == v_nodes_.size()) {
+                        break;
+                    }
+                    const size_t id = dq_ready_.front();
+                    dq_ready_.pop_front();
+                    lock.unlock();
+                    RunNode(id);
+                    lock.lock();
+                }
+
+                if (error_) {
+                    std::rethrow_exception(error_);
+                }
+            }
+
+        private:
+            std::vector<Node>& v_nodes_;
+            TaskPool& pool_;
+            std::mutex mutex_;
+            std::condition_variable changed_;
+            std::deque<size_t> dq_ready_;
+            std::vector<size_t> v_waiting_;
+            size_t done_count_ = 0;
+            std::exception_ptr error_;
+
+            // выполняет задачу и освобождает ожидающие ее. После ошибки задачи только отмечаются выполненными
+            void RunNode(size_t id) {
+                bool is_failed;
+                {
+                    std::lock_guard lock(mutex_);
+                    is_failed = static_cast<bool>(error_);
+                }
+
+                std::exception_ptr error;
+                if (!is_failed) {
+                    try {
+                        v_nodes_[id].task();
+                    }
+                    catch (...) {
+                        error = std::current_exception();
+                    }
+                }
+
+                std::lock_guard lock(mutex_);
+                if (error && !error_) {
+                    error_ = error;
+                }
+                size_t ready_count = 0;
+                for (const size_t dependent : v_nodes_[id].v_dependents) {
+                    if (--v_waiting_[dependent] == 0) {
+                        dq_ready_.push_back(dependent);
+                        ++ready_count;
+                    }
+                }
+                ++done_count_;
+                changed_.notify_all();
+                // одну освободившуюся задачу подхватит вызывающий поток, остальные отдаются пулу
+                SubmitHelpers(ready_count - std::min<size_t>(ready_count, 1));
+            }
+
+            // помощник выполняет одну готовую задачу, если она еще осталась; вызывается под mutex_
+            void SubmitHelpers(size_t count) {
+                if (pool_.GetThreadCount() == 1) {
+                    return;
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    pool_.Submit([self = this->shared_from_this()] {
+                        size_t id;
+                        {
+                            std::lock_guard lock(self->mutex_);
+                            if (self->dq_ready_.empty()) {
+                                return;
+                            }
+                            id = self->dq_ready_.front();
+                            self->dq_ready_.pop_front();
+                        }
+                        self->RunNode(id);
+                    });
+                }
+            }
+        };
+
+    }   // namespace
+
+    TaskPool::TaskPool(size_t worker_count) {
+        v_workers_.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i) {
+            v_workers_.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    TaskPool::~TaskPool() {
+        {
+            std::lock_guard lock(mutex_);
+            is_stopped_ = true;
+        }
+        has_task_.notify_all();
+        for (std::thread& worker : v_workers_) {
+            worker.join();
+        }
+    }
+
+    size_t TaskPool::DefaultWorkerCount() {
+        const size_t hardware_threads = std::thread::hardware_concurrency();
+        return hardware_threads > 1 ? hardware_threads - 1 : 0;
+    }
+
+    size_t TaskPool::GetThreadCount() const {
+        return v_workers_.size() + 1;
+    }
+
+    void TaskPool::ParallelFor(size_t count, const std::function<void(size_t)>& fn) {
+
+        if (count == 0) {
+            return;
+        }
+        if (v_workers_.empty() || count == 1) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(i);
+            }
+            return;
+        }
+
+        // кусков в несколько раз больше, чем потоков, чтобы неравные по времени куски выравнивались
+        constexpr size_t CHUNKS_PER_THREAD = 4;
+        auto state = std::make_shared<ParallelForState>();
+        state->fn = &fn;
+        state->count = count;
+        state->chunk_size = (count + GetThreadCount() * CHUNKS_PER_THREAD - 1) / (GetThreadCount() * CHUNKS_PER_THREAD);
+        state->chunk_count = (count + state->chunk_size - 1) / state->chunk_size;
+
+        // помощник, опоздавший к разбору кусков, завершается, не обращаясь к fn
+        const size_t helper_count = std::min(v_workers_.size(), state->chunk_count - 1);
+        for (size_t i = 0; i < helper_count; ++i) {
+            Submit([state] { state->RunChunks(); });
+        }
+        state->RunChunks();
+
+        // оставшиеся куски уже выполняются другими потоками
+        std::unique_lock lock(state->mutex);
+        state->all_done.wait(lock, [&state] { return state->done_chunks == state->chunk_count; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+
+    }
+
+    void TaskPool::Submit(std::function<void()> task) {
+        {
+            std::lock_guard lock(mutex_);
+            dq_tasks_.push_back(std::move(task));
+        }
+        has_task_.notify_one();
+    }
+
+    void TaskPool::WorkerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                has_task_.wait(lock, [this] { return is_stopped_ || !dq_tasks_.empty(); });
+                if (dq_tasks_.empty()) {
+                    return;
+                }
+                task = std::move(dq_tasks_.front());
+                dq_tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    TaskGraph::TaskId TaskGraph::Add(std::function<void()> task, std::initializer_list<TaskId> dependencies) {
+        const TaskId id = v_nodes_.size();
+        v_nodes_.push_back({ std::move(task), {}, dependencies.size() });
+        for (const TaskId dependency : dependencies) {
+            v_nodes_.at(dependency).v_dependents.push_back(id);
+        }
+        return id;
+    }
+
+    void TaskGraph::Run(TaskPool& pool) {
+        std::make_shared<GraphRun<Node>>(v_nodes_, pool)->Run();
+    }
+
+}   // namespace transport_catalog
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace transport_catalog {
+
+    // Пул рабочих потоков для построения снимка каталога.
+    // Поток, запустивший работу, сам выполняет ее часть и не простаивает в ожидании,
+    // поэтому вложенный запуск из задачи пула не приводит к взаимной блокировке.
+    // Пул без рабочих потоков выполняет все в вызывающем потоке
+    class TaskPool {
+    public:
+        // рабочих потоков на один меньше числа ядер: еще одно ядро занимает вызывающий поток
+        explicit TaskPool(size_t worker_count = DefaultWorkerCount());
+        ~TaskPool();
+
+        TaskPool(const TaskPool&) = delete;
+        TaskPool& operator=(const TaskPool&) = delete;
+
+        static size_t DefaultWorkerCount();
+
+        // число потоков, выполняющих работу, вместе с вызывающим
+        size_t GetThreadCount() const;
+        // выполняет fn(i) для всех i от 0 до count, порядок и поток вызовов не заданы.
+        // Возвращает управление, когда все вызовы завершены. Первое исключение из fn пробрасывается
+        void ParallelFor(size_t count, const std::function<void(size_t)>& fn);
+        // ставит задачу в очередь рабочих потоков
+        void Submit(std::function<void()> task);
+
+    private:
+        std::vector<std::thread> v_workers_;
+        std::deque<std::function<void()>> dq_tasks_;
+        std::mutex mutex_;
+        std::condition_variable has_task_;
+        bool is_stopped_ = false;
+
+        void WorkerLoop();
+    };
+
+    // Граф задач: задача запускается, когда завершены все задачи, от которых она зависит.
+    // Независимые задачи выполняются параллельно в пуле
+    class TaskGraph {
+    public:
+        using TaskId = size_t;
+
+        // добавляет задачу, зависимости должны быть добавлены раньше нее
+        TaskId Add(std::function<void()> task, std::initializer_list<TaskId> dependencies = {});
+        // выполняет все задачи и возвращает управление после завершения последней.
+        // После исключения в задаче новые задачи не запускаются, исключение пробрасывается
+        void Run(TaskPool& pool);
+
+    private:
+        struct Node {
+            std::function<void()> task;
+            std::vector<TaskId> v_dependents; // задачи, ожидающие эту
+            size_t dependency_count = 0;
+        };
+
+        std::vector<Node> v_nodes_;
+    };
+
+}   // namespace transport_catalog
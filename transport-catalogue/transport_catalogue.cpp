@@ -1,20 +1,29 @@
 ﻿#include "transport_catalogue.h"
+#include "json.h"
+#include "visited_set.h"
 
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
 #include <utility>
-#include <unordered_set>
 
 namespace transport_catalog {
 
-    Stop* TransportCatalogue::AddStop(const std::string& name, const double latitude, const double longitude) {
+    namespace {
+
+        // последнее выданное поколение каталога
+        std::atomic<uint64_t> next_generation{ 0 };
+
+    }   // namespace
+
+    Stop* TransportCatalogue::AddStop(std::string name, const double latitude, const double longitude) {
+
+        CheckNotFrozen();
 
         geo::Coordinates coord{ latitude, longitude };
-        Stop stop{ name, std::move(coord) };
+        Stop stop{ d_pending_names_.emplace_back(std::move(name)), std::move(coord), d_stops_.size() };
         auto& el = d_stops_.emplace_back(std::move(stop));
         um_stopname_to_stop_.emplace(el.name, &el);
-        // добавляем. если только такой остановки нет
-        if (um_stops_info_.count(el.name) == 0) {
-            um_stops_info_.emplace(el.name, std::set<std::string_view>());
-        }
 
         return &el;
 
@@ -29,24 +38,32 @@ namespace transport_catalog {
         return it->second;
     }
 
-    Bus* TransportCatalogue::AddBus(const std::string& name, const std::vector<std::string>& v_stops, const bool is_roundtrip) {
+    Bus* TransportCatalogue::AddBus(std::string name, const std::vector<std::string>& v_stops, const bool is_roundtrip) {
+
+        CheckNotFrozen();
 
         std::vector<Stop*> v_ptr_stops;
+        v_ptr_stops.reserve(v_stops.size());
 
         for (const std::string& stop_name : v_stops) {
             auto& curr_stop = um_stopname_to_stop_.at(stop_name);
             v_ptr_stops.push_back(curr_stop);
         }
 
-        Bus bus{ name, std::move(v_ptr_stops), is_roundtrip };
+        return AddBus(std::move(name), std::move(v_ptr_stops), is_roundtrip);
+
+    }
+
+    Bus* TransportCatalogue::AddBus(std::string name, std::vector<Stop*> v_stops, const bool is_roundtrip) {
+
+        CheckNotFrozen();
+
+        std::vector<Stop*>& v_ptr_stops = d_pending_routes_.emplace_back(std::move(v_stops));
+
+        Bus bus{ d_pending_names_.emplace_back(std::move(name)), StopsSpan{ v_ptr_stops.data(), v_ptr_stops.size() }, is_roundtrip };
         auto& el = d_buses_.emplace_back(std::move(bus));
         um_busname_to_bus_.emplace(el.name, &el);
 
-        // добавим в остановки автобусы
-        for (const auto& stop : el.stops) {
-            um_stops_info_.at(stop->name).insert(el.name);
-        }
-
         return &el;
 
     }
@@ -66,19 +83,260 @@ namespace transport_catalog {
 
     }
 
-    std::tuple<bool, std::set<std::string_view>*> TransportCatalogue::GetStopInfo(const std::string_view& stop_name) const {
+    std::optional<TransportCatalogue::BusesRange> TransportCatalogue::GetStopInfo(const std::string_view& stop_name) const {
 
-        const auto it = um_stops_info_.find(stop_name);
-        if (it == um_stops_info_.cend()) {
-            return std::make_tuple(false, nullptr);
+        const auto it = um_stopname_to_stop_.find(stop_name);
+        if (it == um_stopname_to_stop_.cend() || it->second->id + 1 >= v_stop_buses_offsets_.size()) {
+            return std::nullopt;
         }
 
-        const std::set<std::string_view>* ptr_buses = &it->second;
+        const size_t id = it->second->id;
+        const auto begin = v_stop_buses_.cbegin();
 
-        return std::make_tuple(true, const_cast<std::set<std::string_view>*>(ptr_buses));
+        return BusesRange{ begin + v_stop_buses_offsets_[id], begin + v_stop_buses_offsets_[id + 1] };
 
     }
 
+    void TransportCatalogue::Freeze(TaskPool& pool) {
+
+        if (is_frozen_) {
+            return;
+        }
+
+        // Каждый шаг только читает то, что подготовили его предшественники, и пишет в свои поля,
+        // поэтому независимые шаги выполняются параллельно. Результат от порядка выполнения не зависит
+        TaskGraph graph;
+        const auto names = graph.Add([this] { CompactNames(); });
+        graph.Add([this] { BuildJsonNames(); }, { names });
+        const auto routes = graph.Add([this] { CompactRoutes(); }, { names });
+        graph.Add([this] { BuildStopsGrid(); }, { names });
+        graph.Add([this] { name_index_.Build(d_stops_, d_buses_); }, { names });
+        graph.Add([this] { BuildStopsIndex(); }, { routes });
+        graph.Add([this, &pool] { BuildRouteStats(pool); }, { routes });
+        graph.Run(pool);
+
+        is_frozen_ = true;
+        generation_ = ++next_generation;
+
+    }
+
+    bool TransportCatalogue::IsFrozen() const {
+        return is_frozen_;
+    }
+
+    uint64_t TransportCatalogue::GetGeneration() const {
+        return generation_;
+    }
+
+    void TransportCatalogue::CheckNotFrozen() const {
+        if (is_frozen_) {
+            throw std::logic_error("TransportCatalogue is frozen");
+        }
+    }
+
+    void TransportCatalogue::CompactNames() {
+
+        size_t total_size = 0;
+        for (const Stop& stop : d_stops_) {
+            total_size += stop.name.size();
+        }
+        for (const Bus& bus : d_buses_) {
+            total_size += bus.name.size();
+        }
+
+        // память выделяется один раз, поэтому представления строк не станут недействительными
+        names_arena_.clear();
+        names_arena_.reserve(total_size);
+
+        auto move_to_arena = [this](std::string_view name) {
+            const size_t offset = names_arena_.size();
+            names_arena_.append(name);
+            return std::string_view{ names_arena_.data() + offset, name.size() };
+        };
+
+        um_stopname_to_stop_.clear();
+        um_stopname_to_stop_.reserve(d_stops_.size());
+        for (Stop& stop : d_stops_) {
+            stop.name = move_to_arena(stop.name);
+            um_stopname_to_stop_.emplace(stop.name, &stop);
+        }
+
+        um_busname_to_bus_.clear();
+        um_busname_to_bus_.reserve(d_buses_.size());
+        for (Bus& bus : d_buses_) {
+            bus.name = move_to_arena(bus.name);
+            um_busname_to_bus_.emplace(bus.name, &bus);
+        }
+
+        std::deque<std::string>().swap(d_pending_names_);
+
+    }
+
+    void TransportCatalogue::BuildJsonNames() {
+
+        // сначала все имена дописываются в хранилище, представления берутся после,
+        // когда строка больше не будет перевыделяться
+        json_names_arena_.clear();
+        json_names_arena_.reserve(names_arena_.size() + 2 * (d_stops_.size() + d_buses_.size()));
+
+        std::vector<size_t> v_ends;
+        v_ends.reserve(d_stops_.size() + d_buses_.size());
+        for (const Stop& stop : d_stops_) {
+            json::AppendQuoted(json_names_arena_, stop.name);
+            v_ends.push_back(json_names_arena_.size());
+        }
+        for (const Bus& bus : d_buses_) {
+            json::AppendQuoted(json_names_arena_, bus.name);
+            v_ends.push_back(json_names_arena_.size());
+        }
+
+        // имя с номером i занимает место от конца предыдущего имени до v_ends[i]
+        size_t index = 0;
+        auto next_view = [this, &v_ends, &index]() {
+            const size_t begin = index == 0 ? 0 : v_ends[index - 1];
+            const size_t end = v_ends[index++];
+            return std::string_view{ json_names_arena_.data() + begin, end - begin };
+        };
+
+        for (Stop& stop : d_stops_) {
+            stop.json_name = next_view();
+        }
+        for (Bus& bus : d_buses_) {
+            bus.json_name = next_view();
+        }
+
+    }
+
+    void TransportCatalogue::CompactRoutes() {
+
+        size_t total_size = 0;
+        for (const Bus& bus : d_buses_) {
+            total_size += bus.stops.size();
+        }
+
+        v_route_stops_.clear();
+        v_route_stops_.reserve(total_size);
+
+        std::vector<size_t> v_offsets;
+        v_offsets.reserve(d_buses_.size());
+        for (const Bus& bus : d_buses_) {
+            v_offsets.push_back(v_route_stops_.size());
+            v_route_stops_.insert(v_route_stops_.end(), bus.stops.begin(), bus.stops.end());
+        }
+
+        // после заполнения массив уже не перевыделяется, можно ссылаться на его участки
+        size_t index = 0;
+        for (Bus& bus : d_buses_) {
+            bus.stops = StopsSpan{ v_route_stops_.data() + v_offsets[index++], bus.stops.size() };
+        }
+
+        std::deque<std::vector<Stop*>>().swap(d_pending_routes_);
+
+    }
+
+    void TransportCatalogue::BuildStopsGrid() {
+
+        v_stop_points_.clear();
+        v_stop_points_.reserve(d_stops_.size());
+        for (const Stop& stop : d_stops_) {
+            v_stop_points_.push_back(geo::PrepareCoordinates(stop.coordinates));
+        }
+
+        stops_grid_.Build(d_stops_, v_stop_points_);
+
+    }
+
+    void TransportCatalogue::BuildStopsIndex() {
+
+        // автобусы в порядке имен, тогда у каждой остановки они окажутся отсортированными
+        std::vector<Bus*> v_buses;
+        v_buses.reserve(d_buses_.size());
+        for (Bus& bus : d_buses_) {
+            v_buses.push_back(&bus);
+        }
+        std::sort(v_buses.begin(), v_buses.end(), [](const Bus* lhs, const Bus* rhs) { return lhs->name < rhs->name; });
+
+        // последний учтенный у остановки автобус, чтобы не учитывать повторные заезды
+        std::vector<const Bus*> v_last_bus(d_stops_.size(), nullptr);
+
+        // первым проходом считаем количество автобусов у каждой остановки
+        v_stop_buses_offsets_.assign(d_stops_.size() + 1, 0);
+        for (const Bus* bus : v_buses) {
+            for (const Stop* stop : bus->stops) {
+                if (v_last_bus[stop->id] != bus) {
+                    v_last_bus[stop->id] = bus;
+                    ++v_stop_buses_offsets_[stop->id + 1];
+                }
+            }
+        }
+
+        for (size_t i = 1; i < v_stop_buses_offsets_.size(); ++i) {
+            v_stop_buses_offsets_[i] += v_stop_buses_offsets_[i - 1];
+        }
+
+        // вторым проходом раскладываем автобусы по местам
+        v_stop_buses_.assign(v_stop_buses_offsets_.back(), nullptr);
+        std::vector<size_t> v_positions(v_stop_buses_offsets_.begin(), v_stop_buses_offsets_.end() - 1);
+        std::fill(v_last_bus.begin(), v_last_bus.end(), nullptr);
+
+        for (Bus* bus : v_buses) {
+            for (const Stop* stop : bus->stops) {
+                if (v_last_bus[stop->id] != bus) {
+                    v_last_bus[stop->id] = bus;
+                    v_stop_buses_[v_positions[stop->id]++] = bus;
+                }
+            }
+        }
+
+    }
+
+    void TransportCatalogue::BuildRouteStats(TaskPool& pool) {
+
+        // автобус пишет только в свои поля, порядок вычисления внутри маршрута тот же, что и при последовательном расчете
+        pool.ParallelFor(d_buses_.size(), [this](size_t index) {
+            Bus& bus = d_buses_[index];
+            bus.unique_stop_count = CountUniqueStops(bus.stops);
+            bus.route_length = ComputeRouteLength(bus.stops, bus.is_roundtrip);
+            // если не кольцевой, сразу же учтем и обратный путь
+            bus.geo_route_length = ComputeGeoLength(bus.stops) * (bus.is_roundtrip ? 1 : 2);
+        });
+
+    }
+
+    size_t TransportCatalogue::CountUniqueStops(const StopsSpan& stops) const {
+
+        // отметки переиспользуются между маршрутами, память выделяется только при росте каталога
+        thread_local VisitedSet visited_stops;
+        visited_stops.Reset(d_stops_.size());
+
+        size_t unique_count = 0;
+        for (const Stop* stop : stops) {
+            if (visited_stops.Insert(stop->id)) {
+                ++unique_count;
+            }
+        }
+
+        return unique_count;
+
+    }
+
+    double TransportCatalogue::ComputeRouteLength(const StopsSpan& stops, const bool is_roundtrip) const {
+        double result = 0;
+
+        for (size_t i = 1; i < stops.size(); ++i) {
+            result += GetDistanceBetweenStops(stops[i - 1], stops[i]);
+        }
+
+        // если не кольцевой, пройдем отрезки в обратную сторону (вдруг расстояние изменилось)
+        if (!is_roundtrip) {
+            for (size_t i = 1; i < stops.size(); ++i) {
+                result += GetDistanceBetweenStops(stops[i], stops[i - 1]);
+            }
+        }
+
+        return result;
+    }
+
     void TransportCatalogue::SetDistanceBetweenStops(Stop* stop1, Stop* stop2, double distance) {
         um_distance_.emplace(std::make_pair(stop1, stop2), distance);
     }
@@ -110,6 +368,42 @@ namespace transport_catalog {
         return d_stops_.size();
     }
 
+    double TransportCatalogue::ComputeGeoLength(const StopsSpan& stops) const {
+
+        if (stops.size() < 2) {
+            return 0.;
+        }
+
+        // буферы переиспользуются между вызовами
+        thread_local std::vector<geo::PreparedCoordinates> v_points;
+        thread_local std::vector<double> v_distances;
+
+        v_points.clear();
+        for (const Stop* stop : stops) {
+            v_points.push_back(is_frozen_ ? v_stop_points_[stop->id] : geo::PrepareCoordinates(stop->coordinates));
+        }
+
+        // отрезки маршрута - пары соседних точек
+        v_distances.resize(v_points.size() - 1);
+        geo::ComputeDistances(v_points.data(), v_points.data() + 1, v_distances.size(), v_distances.data());
+
+        double result = 0.;
+        for (const double distance : v_distances) {
+            result += distance;
+        }
+
+        return result;
+
+    }
+
+    std::vector<NearbyStop> TransportCatalogue::FindNearestStops(geo::Coordinates center, double radius, size_t limit) const {
+        return stops_grid_.FindNearest(center, radius, limit);
+    }
+
+    std::vector<NameMatch> TransportCatalogue::SuggestNames(std::string_view query, size_t limit) const {
+        return name_index_.Suggest(query, limit);
+    }
+
     const std::unordered_map<std::pair<Stop*, Stop*>, double, StopsPairHasher>& TransportCatalogue::GetAllDistance() const
     {
         return um_distance_;
@@ -1,35 +1,59 @@
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 #include <deque>
 #include <vector>
-#include <set>
 #include <string>
 #include <string_view>
 #include <tuple>
 #include <functional>
+#include <optional>
 #include <type_traits>
 
 #include "domain.h"
+#include "name_index.h"
+#include "ranges.h"
+#include "spatial_index.h"
+#include "task_pool.h"
 
 
 namespace transport_catalog {
 
     class TransportCatalogue {
     public:       
+        // диапазон автобусов, проходящих через остановку (отсортированы по имени)
+        using BusesRange = ranges::Range<std::vector<Bus*>::const_iterator>;
+
         TransportCatalogue() = default;
+        // остановки, автобусы и индексы ссылаются друг на друга и на хранилища каталога по адресам,
+        // копия или перемещенный каталог ссылались бы на чужие данные
+        TransportCatalogue(const TransportCatalogue&) = delete;
+        TransportCatalogue& operator=(const TransportCatalogue&) = delete;
+        TransportCatalogue(TransportCatalogue&&) = delete;
+        TransportCatalogue& operator=(TransportCatalogue&&) = delete;
         // добавляет остановку
-        Stop* AddStop(const std::string& name, const double latitude, const double longitude);
+        Stop* AddStop(std::string name, const double latitude, const double longitude);
         // ищет и возвращает остановку по имени
         Stop* FindStop(const std::string& name) const;
         // добавляет автобус с маршрутом
-        Bus* AddBus(const std::string& name, const std::vector<std::string>& v_stops, const bool is_roundtrip);
+        Bus* AddBus(std::string name, const std::vector<std::string>& v_stops, const bool is_roundtrip);
+        // добавляет автобус с маршрутом по уже найденным остановкам
+        Bus* AddBus(std::string name, std::vector<Stop*> v_stops, const bool is_roundtrip);
         // ищет и возвращает автобус по имени
         Bus* FindBus(const std::string_view& name) const;
         // возвращает маршрут поимени автобуса
         Bus* GetBusInfo(const std::string_view& bus_name) const;
-        // возвращает информацию об остановке
-        std::tuple<bool, std::set<std::string_view>*> GetStopInfo(const std::string_view& stop_name) const;
+        // возвращает информацию об остановке (автобусы, проходящие через нее)
+        std::optional<BusesRange> GetStopInfo(const std::string_view& stop_name) const;
+        // завершает заполнение каталога: уплотняет имена и маршруты, строит индексы и статистику маршрутов
+        // на потоках пула. После вызова каталог только читается, добавление остановок и автобусов запрещено
+        void Freeze(TaskPool& pool);
+        // возвращает признак завершенного заполнения каталога
+        bool IsFrozen() const;
+        // Возвращает поколение каталога: номер, который Freeze выдает каталогу из общего для процесса счетчика.
+        // Разные заполненные каталоги, в том числе загруженные заново, имеют разные поколения, до Freeze поколение 0
+        uint64_t GetGeneration() const;
         // установить расстояние между остановками
         void SetDistanceBetweenStops(Stop* stop1, Stop* stop2, double distance);
         // получить расстояние между остановками
@@ -40,18 +64,55 @@ namespace transport_catalog {
         const std::unordered_map<std::string_view, Stop*>& GetAllStops() const;
         // возвращает количество остановок
         const size_t GetNumberOfStops() const;
+        // возвращает географическую длину пути, проходящего через остановки по порядку
+        double ComputeGeoLength(const StopsSpan& stops) const;
+        // возвращает ближайшие к точке остановки в радиусе radius метров (не более limit, 0 - без ограничения)
+        std::vector<NearbyStop> FindNearestStops(geo::Coordinates center, double radius, size_t limit) const;
+        // возвращает имена остановок и автобусов, подходящие под часть имени или имя с опечаткой
+        std::vector<NameMatch> SuggestNames(std::string_view query, size_t limit) const;
         // возвращает все хранимые расстояния с остановками
         const std::unordered_map<std::pair<Stop*, Stop*>, double, StopsPairHasher>& GetAllDistance() const;
 
     private:
         std::deque<Stop> d_stops_{}; // содержит все остановки
         std::deque<Bus> d_buses_{}; // содержит все автобусы
+        bool is_frozen_{ false };
+        uint64_t generation_{ 0 };
+        // хранилища до вызова Freeze: каждое имя и каждый маршрут выделены отдельно
+        std::deque<std::string> d_pending_names_{};
+        std::deque<std::vector<Stop*>> d_pending_routes_{};
+        // хранилища после вызова Freeze: все имена в одной строке, все маршруты в одном массиве
+        std::string names_arena_{};
+        std::string json_names_arena_{}; // имена, подготовленные для вывода в JSON, в том же порядке
+        std::vector<Stop*> v_route_stops_{};
         // хеш-таблицы
         std::unordered_map<std::string_view, Stop*> um_stopname_to_stop_{}; // содержит имя остановки (представление строки) и указатель на остановку
         std::unordered_map<std::string_view, Bus*> um_busname_to_bus_{};  // содержит имя автобуса (представление строки) и указатель на автобус
-        std::unordered_map<std::string_view, std::set<std::string_view>> um_stops_info_{}; // хранит все маршруты проходящие, через остановку
+        std::vector<Bus*> v_stop_buses_{}; // автобусы всех остановок подряд, для каждой остановки отсортированы по имени
+        std::vector<size_t> v_stop_buses_offsets_{}; // начало автобусов остановки с номером id в v_stop_buses_ (размер - число остановок + 1)
         std::unordered_map<std::pair<Stop*, Stop*>, double, StopsPairHasher> um_distance_{}; // хранит расстояние между остановками
+        std::vector<geo::PreparedCoordinates> v_stop_points_{}; // координаты остановок с синусом и косинусом широты по номеру остановки, строятся в Freeze
+        StopsGrid stops_grid_{}; // пространственный индекс остановок, строится в Freeze
+        NameIndex name_index_{}; // индекс имен для подсказок, строится в Freeze
 
+        // проверяет, что каталог еще можно изменять
+        void CheckNotFrozen() const;
+        // переносит имена в общее хранилище и перестраивает хеш-таблицы имен
+        void CompactNames();
+        // один раз экранирует имена для вывода в JSON
+        void BuildJsonNames();
+        // переносит маршруты в общий массив остановок
+        void CompactRoutes();
+        // строит индекс "остановка -> автобусы"
+        void BuildStopsIndex();
+        // готовит координаты остановок и строит по ним сетку
+        void BuildStopsGrid();
+        // считает длины маршрута и число уникальных остановок, автобусы обрабатываются параллельно
+        void BuildRouteStats(TaskPool& pool);
+        // возвращает кол-во уникальных остановок
+        size_t CountUniqueStops(const StopsSpan& stops) const;
+        // возвращает длину маршрута по дорожным расстояниям
+        double ComputeRouteLength(const StopsSpan& stops, const bool is_roundtrip) const;
     };
 
 } //transport_catalog
\ No newline at end of file
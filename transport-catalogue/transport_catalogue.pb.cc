@@ -96,6 +96,7 @@ PROTOBUF_CONSTEXPR TransportCatalogue::TransportCatalogue(
     /*decltype(_impl_.stops_)*/{::_pbi::ConstantInitialized()}
   , /*decltype(_impl_.bus_)*/{}
   , /*decltype(_impl_.distance_)*/{}
+  , /*decltype(_impl_.rendered_map_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.map_settings_)*/nullptr
   , /*decltype(_impl_.router_settings_)*/nullptr
   , /*decltype(_impl_._cached_size_)*/{}} {}
@@ -169,6 +170,7 @@ const uint32_t TableStruct_transport_5fcatalogue_2eproto::offsets[] PROTOBUF_SEC
   PROTOBUF_FIELD_OFFSET(::transport_catalog_serialize::TransportCatalogue, _impl_.distance_),
   PROTOBUF_FIELD_OFFSET(::transport_catalog_serialize::TransportCatalogue, _impl_.map_settings_),
   PROTOBUF_FIELD_OFFSET(::transport_catalog_serialize::TransportCatalogue, _impl_.router_settings_),
+  PROTOBUF_FIELD_OFFSET(::transport_catalog_serialize::TransportCatalogue, _impl_.rendered_map_),
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::transport_catalog_serialize::Coordinates)},
@@ -198,7 +200,7 @@ const char descriptor_table_protodef_transport_5fcatalogue_2eproto[] PROTOBUF_SE
   "\003Bus\022\014\n\004name\030\001 \001(\014\022\017\n\007stop_id\030\002 \003(\004\022\024\n\014i"
   "s_roundtrip\030\003 \001(\010\"F\n\010Distance\022\024\n\014stop_id"
   "_from\030\001 \001(\004\022\022\n\nstop_id_to\030\002 \001(\004\022\020\n\010dista"
-  "nce\030\003 \001(\001\"\236\003\n\022TransportCatalogue\022I\n\005stop"
+  "nce\030\003 \001(\001\"\264\003\n\022TransportCatalogue\022I\n\005stop"
   "s\030\001 \003(\0132:.transport_catalog_serialize.Tr"
   "ansportCatalogue.StopsEntry\022-\n\003bus\030\002 \003(\013"
   "2 .transport_catalog_serialize.Bus\0227\n\010di"
@@ -206,9 +208,10 @@ const char descriptor_table_protodef_transport_5fcatalogue_2eproto[] PROTOBUF_SE
   "ze.Distance\022>\n\014map_settings\030\004 \001(\0132(.tran"
   "sport_catalog_serialize.MapSettings\022D\n\017r"
   "outer_settings\030\005 \001(\0132+.transport_catalog"
-  "_serialize.RouterSettings\032O\n\nStopsEntry\022"
-  "\013\n\003key\030\001 \001(\004\0220\n\005value\030\002 \001(\0132!.transport_"
-  "catalog_serialize.Stop:\0028\001b\006proto3"
+  "_serialize.RouterSettings\022\024\n\014rendered_ma"
+  "p\030\006 \001(\014\032O\n\nStopsEntry\022\013\n\003key\030\001 \001(\004\0220\n\005va"
+  "lue\030\002 \001(\0132!.transport_catalog_serialize."
+  "Stop:\0028\001b\006proto3"
   ;
 static const ::_pbi::DescriptorTable* const descriptor_table_transport_5fcatalogue_2eproto_deps[2] = {
   &::descriptor_table_map_5frenderer_2eproto,
@@ -216,7 +219,7 @@ static const ::_pbi::DescriptorTable* const descriptor_table_transport_5fcatalog
 };
 static ::_pbi::once_flag descriptor_table_transport_5fcatalogue_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_transport_5fcatalogue_2eproto = {
-    false, false, 794, descriptor_table_protodef_transport_5fcatalogue_2eproto,
+    false, false, 816, descriptor_table_protodef_transport_5fcatalogue_2eproto,
     "transport_catalogue.proto",
     &descriptor_table_transport_5fcatalogue_2eproto_once, descriptor_table_transport_5fcatalogue_2eproto_deps, 2, 6,
     schemas, file_default_instances, TableStruct_transport_5fcatalogue_2eproto::offsets,
@@ -1278,12 +1281,21 @@ TransportCatalogue::TransportCatalogue(const TransportCatalogue& from)
       /*decltype(_impl_.stops_)*/{}
     , decltype(_impl_.bus_){from._impl_.bus_}
     , decltype(_impl_.distance_){from._impl_.distance_}
+    , decltype(_impl_.rendered_map_){}
     , decltype(_impl_.map_settings_){nullptr}
     , decltype(_impl_.router_settings_){nullptr}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
   _this->_impl_.stops_.MergeFrom(from._impl_.stops_);
+  _impl_.rendered_map_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.rendered_map_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_rendered_map().empty()) {
+    _this->_impl_.rendered_map_.Set(from._internal_rendered_map(), 
+      _this->GetArenaForAllocation());
+  }
   if (from._internal_has_map_settings()) {
     _this->_impl_.map_settings_ = new ::transport_catalog_serialize::MapSettings(*from._impl_.map_settings_);
   }
@@ -1301,10 +1313,15 @@ inline void TransportCatalogue::SharedCtor(
       /*decltype(_impl_.stops_)*/{::_pbi::ArenaInitialized(), arena}
     , decltype(_impl_.bus_){arena}
     , decltype(_impl_.distance_){arena}
+    , decltype(_impl_.rendered_map_){}
     , decltype(_impl_.map_settings_){nullptr}
     , decltype(_impl_.router_settings_){nullptr}
     , /*decltype(_impl_._cached_size_)*/{}
   };
+  _impl_.rendered_map_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.rendered_map_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 TransportCatalogue::~TransportCatalogue() {
@@ -1323,6 +1340,7 @@ inline void TransportCatalogue::SharedDtor() {
   _impl_.stops_.~MapField();
   _impl_.bus_.~RepeatedPtrField();
   _impl_.distance_.~RepeatedPtrField();
+  _impl_.rendered_map_.Destroy();
   if (this != internal_default_instance()) delete _impl_.map_settings_;
   if (this != internal_default_instance()) delete _impl_.router_settings_;
 }
@@ -1344,6 +1362,7 @@ void TransportCatalogue::Clear() {
   _impl_.stops_.Clear();
   _impl_.bus_.Clear();
   _impl_.distance_.Clear();
+  _impl_.rendered_map_.ClearToEmpty();
   if (GetArenaForAllocation() == nullptr && _impl_.map_settings_ != nullptr) {
     delete _impl_.map_settings_;
   }
@@ -1416,6 +1435,15 @@ const char* TransportCatalogue::_InternalParse(const char* ptr, ::_pbi::ParseCon
         } else
           goto handle_unusual;
         continue;
+      // bytes rendered_map = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          auto str = _internal_mutable_rendered_map();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -1492,6 +1520,12 @@ uint8_t* TransportCatalogue::_InternalSerialize(
         _Internal::router_settings(this).GetCachedSize(), target, stream);
   }
 
+  // bytes rendered_map = 6;
+  if (!this->_internal_rendered_map().empty()) {
+    target = stream->WriteBytesMaybeAliased(
+        6, this->_internal_rendered_map(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -1531,6 +1565,13 @@ size_t TransportCatalogue::ByteSizeLong() const {
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
   }
 
+  // bytes rendered_map = 6;
+  if (!this->_internal_rendered_map().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_rendered_map());
+  }
+
   // .transport_catalog_serialize.MapSettings map_settings = 4;
   if (this->_internal_has_map_settings()) {
     total_size += 1 +
@@ -1566,6 +1607,9 @@ void TransportCatalogue::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, con
   _this->_impl_.stops_.MergeFrom(from._impl_.stops_);
   _this->_impl_.bus_.MergeFrom(from._impl_.bus_);
   _this->_impl_.distance_.MergeFrom(from._impl_.distance_);
+  if (!from._internal_rendered_map().empty()) {
+    _this->_internal_set_rendered_map(from._internal_rendered_map());
+  }
   if (from._internal_has_map_settings()) {
     _this->_internal_mutable_map_settings()->::transport_catalog_serialize::MapSettings::MergeFrom(
         from._internal_map_settings());
@@ -1590,10 +1634,16 @@ bool TransportCatalogue::IsInitialized() const {
 
 void TransportCatalogue::InternalSwap(TransportCatalogue* other) {
   using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   _impl_.stops_.InternalSwap(&other->_impl_.stops_);
   _impl_.bus_.InternalSwap(&other->_impl_.bus_);
   _impl_.distance_.InternalSwap(&other->_impl_.distance_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.rendered_map_, lhs_arena,
+      &other->_impl_.rendered_map_, rhs_arena
+  );
   ::PROTOBUF_NAMESPACE_ID::internal::memswap<
       PROTOBUF_FIELD_OFFSET(TransportCatalogue, _impl_.router_settings_)
       + sizeof(TransportCatalogue::_impl_.router_settings_)
@@ -923,6 +923,7 @@ class TransportCatalogue final :
     kStopsFieldNumber = 1,
     kBusFieldNumber = 2,
     kDistanceFieldNumber = 3,
+    kRenderedMapFieldNumber = 6,
     kMapSettingsFieldNumber = 4,
     kRouterSettingsFieldNumber = 5,
   };
@@ -979,6 +980,20 @@ class TransportCatalogue final :
   const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::transport_catalog_serialize::Distance >&
       distance() const;
 
+  // bytes rendered_map = 6;
+  void clear_rendered_map();
+  const std::string& rendered_map() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_rendered_map(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_rendered_map();
+  PROTOBUF_NODISCARD std::string* release_rendered_map();
+  void set_allocated_rendered_map(std::string* rendered_map);
+  private:
+  const std::string& _internal_rendered_map() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_rendered_map(const std::string& value);
+  std::string* _internal_mutable_rendered_map();
+  public:
+
   // .transport_catalog_serialize.MapSettings map_settings = 4;
   bool has_map_settings() const;
   private:
@@ -1030,6 +1045,7 @@ class TransportCatalogue final :
         ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_MESSAGE> stops_;
     ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::transport_catalog_serialize::Bus > bus_;
     ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::transport_catalog_serialize::Distance > distance_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr rendered_map_;
     ::transport_catalog_serialize::MapSettings* map_settings_;
     ::transport_catalog_serialize::RouterSettings* router_settings_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
@@ -1702,6 +1718,56 @@ inline void TransportCatalogue::set_allocated_router_settings(::transport_catalo
   // @@protoc_insertion_point(field_set_allocated:transport_catalog_serialize.TransportCatalogue.router_settings)
 }
 
+// bytes rendered_map = 6;
+inline void TransportCatalogue::clear_rendered_map() {
+  _impl_.rendered_map_.ClearToEmpty();
+}
+inline const std::string& TransportCatalogue::rendered_map() const {
+  // @@protoc_insertion_point(field_get:transport_catalog_serialize.TransportCatalogue.rendered_map)
+  return _internal_rendered_map();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void TransportCatalogue::set_rendered_map(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.rendered_map_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:transport_catalog_serialize.TransportCatalogue.rendered_map)
+}
+inline std::string* TransportCatalogue::mutable_rendered_map() {
+  std::string* _s = _internal_mutable_rendered_map();
+  // @@protoc_insertion_point(field_mutable:transport_catalog_serialize.TransportCatalogue.rendered_map)
+  return _s;
+}
+inline const std::string& TransportCatalogue::_internal_rendered_map() const {
+  return _impl_.rendered_map_.Get();
+}
+inline void TransportCatalogue::_internal_set_rendered_map(const std::string& value) {
+  
+  _impl_.rendered_map_.Set(value, GetArenaForAllocation());
+}
+inline std::string* TransportCatalogue::_internal_mutable_rendered_map() {
+  
+  return _impl_.rendered_map_.Mutable(GetArenaForAllocation());
+}
+inline std::string* TransportCatalogue::release_rendered_map() {
+  // @@protoc_insertion_point(field_release:transport_catalog_serialize.TransportCatalogue.rendered_map)
+  return _impl_.rendered_map_.Release();
+}
+inline void TransportCatalogue::set_allocated_rendered_map(std::string* rendered_map) {
+  if (rendered_map != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.rendered_map_.SetAllocated(rendered_map, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.rendered_map_.IsDefault()) {
+    _impl_.rendered_map_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:transport_catalog_serialize.TransportCatalogue.rendered_map)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -1,5 +1,10 @@
 ﻿#include "transport_router.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
 namespace transport_catalog {
 
 
@@ -17,6 +22,14 @@ namespace transport_catalog {
 		bus_velocity_ = velocity;
 	}
 
+	void TransportRouter::SetPedestrianVelocity(double velocity) {
+		pedestrian_velocity_ = velocity;
+	}
+
+	void TransportRouter::SetMaxWalkDistance(double distance) {
+		max_walk_distance_ = distance;
+	}
+
 	double TransportRouter::GetWaitTime() const
 	{
 		return bus_wait_time_;
@@ -27,19 +40,29 @@ namespace transport_catalog {
 		return bus_velocity_;
 	}
 
-	void TransportRouter::BuildGraph(const TransportCatalogue& tc) {
+	double TransportRouter::GetPedestrianVelocity() const
+	{
+		return pedestrian_velocity_;
+	}
+
+	double TransportRouter::GetMaxWalkDistance() const
+	{
+		return max_walk_distance_;
+	}
+
+	void TransportRouter::BuildGraph(const TransportCatalogue& tc, TaskPool& pool) {
 		const size_t number_edges = tc.GetNumberOfStops() * 2; // т.к. у каждой остановки по две вершины
 
 		graph_ptr_ = std::make_unique<CurrentGraph>(number_edges);
 
 		AddEdgeStops(tc.GetAllStops());
-		AddEdgeBuses(tc);
+		AddEdgeBuses(tc, pool);
 
-		SetRouter();
+		SetRouter(pool);
 
 	}
 
-	std::optional<TransportRouter::RouteInfoResponse> TransportRouter::GetRouteInfo(const std::string& stop_from, const std::string& stop_to) {
+	std::optional<TransportRouter::RouteInfoResponse> TransportRouter::GetRouteInfo(const std::string& stop_from, const std::string& stop_to) const {
 		if (!router_ptr_) { return RouteInfoResponse{}; }
 
 		const auto route_info = router_ptr_->BuildRoute(um_vertexes_of_stops_.at(stop_from), um_vertexes_of_stops_.at(stop_to));
@@ -56,67 +79,191 @@ namespace transport_catalog {
 		return RouteInfoResponse{ route_info->weight.weight, std::move(v_result) };
 	}
 
+	std::optional<TransportRouter::RouteInfoResponse> TransportRouter::GetJourneyInfo(const TransportCatalogue& tc, geo::Coordinates from, geo::Coordinates to) const {
+		
+		static const double INFINITE_TIME = std::numeric_limits<double>::infinity();
+
+		// лучший вариант на текущий момент - дойти пешком, если это не слишком далеко
+		double best_time = INFINITE_TIME;
+		const double direct_distance = geo::ComputeDistance(from, to);
+		if (direct_distance <= max_walk_distance_) {
+			best_time = CalculateWalkTime(direct_distance);
+		}
+
+		std::optional<graph::VertexId> best_vertex;
+
+		if (graph_ptr_) {
+			const size_t vertex_count = graph_ptr_->GetVertexCount();
+
+			std::vector<double> v_times(vertex_count, INFINITE_TIME);
+			std::vector<std::optional<graph::EdgeId>> v_prev_edges(vertex_count);
+			std::vector<const Stop*> v_access_stops(vertex_count, nullptr); // остановки, до которых идем пешком от начала
+			std::vector<const Stop*> v_egress_stops(vertex_count, nullptr); // остановки, от которых идем пешком до цели
+			std::vector<double> v_egress_times(vertex_count, INFINITE_TIME);
+
+			using QueueItem = std::pair<double, graph::VertexId>;
+			std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+
+			// все остановки в пешей доступности от начала становятся источниками поиска со своим временем старта
+			for (const NearbyStop& access : tc.FindNearestStops(from, max_walk_distance_, 0)) {
+				const graph::VertexId vertex = um_vertexes_of_stops_.at(access.stop->name);
+				v_times[vertex] = CalculateWalkTime(access.distance);
+				v_access_stops[vertex] = access.stop;
+				queue.push({ v_times[vertex], vertex });
+			}
+
+			for (const NearbyStop& egress : tc.FindNearestStops(to, max_walk_distance_, 0)) {
+				const graph::VertexId vertex = um_vertexes_of_stops_.at(egress.stop->name);
+				v_egress_times[vertex] = CalculateWalkTime(egress.distance);
+				v_egress_stops[vertex] = egress.stop;
+			}
+
+			while (!queue.empty()) {
+				const auto [time, vertex] = queue.top();
+				queue.pop();
+
+				// дальнейшие вершины не улучшат найденный путь
+				if (time >= best_time) {
+					break;
+				}
+				if (time > v_times[vertex]) {
+					continue;
+				}
+
+				if (time + v_egress_times[vertex] < best_time) {
+					best_time = time + v_egress_times[vertex];
+					best_vertex = vertex;
+				}
+
+				for (const graph::EdgeId edge_id : graph_ptr_->GetIncidentEdges(vertex)) {
+					const auto& edge = graph_ptr_->GetEdge(edge_id);
+					const double next_time = time + edge.weight.weight;
+					if (next_time < v_times[edge.to]) {
+						v_times[edge.to] = next_time;
+						v_prev_edges[edge.to] = edge_id;
+						queue.push({ next_time, edge.to });
+					}
+				}
+			}
+
+			if (best_vertex) {
+				std::vector<RouteWeight> v_result;
+				v_result.push_back({ v_egress_stops[*best_vertex]->json_name, v_egress_times[*best_vertex], false, 0, true });
+
+				// идем по ребрам назад до вершины, с которой начался поиск
+				graph::VertexId start_vertex = *best_vertex;
+				for (std::optional<graph::EdgeId> edge_id = v_prev_edges[start_vertex]; edge_id; edge_id = v_prev_edges[start_vertex]) {
+					const auto& edge = graph_ptr_->GetEdge(*edge_id);
+					v_result.push_back(edge.weight);
+					start_vertex = edge.from;
+				}
+
+				v_result.push_back({ v_access_stops[start_vertex]->json_name, v_times[start_vertex], false, 0, true });
+				std::reverse(v_result.begin(), v_result.end());
+
+				return RouteInfoResponse{ best_time, std::move(v_result) };
+			}
+		}
+
+		if (best_time == INFINITE_TIME) {
+			return std::nullopt;
+		}
+
+		return RouteInfoResponse{ best_time, { RouteWeight{ "", best_time, false, 0, true } } };
+	}
+
 	void TransportRouter::AddEdgeStops(const std::unordered_map<std::string_view, Stop*> all_stops) {
 
 		graph::VertexId vertex = 0;
 		for (const auto& [name_stop, stop] : all_stops) {
 			um_vertexes_of_stops_[name_stop] = vertex;
-			graph_ptr_->AddEdge({ vertex, ++vertex, {name_stop, GetWaitTime(), true, 0} });
+			graph_ptr_->AddEdge({ vertex, ++vertex, {stop->json_name, GetWaitTime(), true, 0} });
 			++vertex; // вершина для следующей остановки
 		}
 
 	}
 
-	void TransportRouter::AddEdgeBuses(const TransportCatalogue& tc) {
-		
+	void TransportRouter::AddEdgeBuses(const TransportCatalogue& tc, TaskPool& pool) {
+
+		std::vector<const Bus*> v_buses;
+		v_buses.reserve(tc.GetAllBuses().size());
 		for (const auto& [name_bus, bus] : tc.GetAllBuses()) {
-			const int count_stops = bus->stops.size();
-			double sum_distance = 0.;
+			v_buses.push_back(bus);
+		}
+
+		std::vector<std::vector<graph::Edge<RouteWeight>>> v_bus_edges(v_buses.size());
+		pool.ParallelFor(v_buses.size(), [this, &tc, &v_buses, &v_bus_edges](size_t index) {
+			v_bus_edges[index] = GetBusEdges(tc, *v_buses[index]);
+		});
+
+		// номера ребер те же, что при последовательном построении
+		for (const auto& v_edges : v_bus_edges) {
+			for (const auto& edge : v_edges) {
+				graph_ptr_->AddEdge(edge);
+			}
+		}
+
+	}
+
+	std::vector<graph::Edge<TransportRouter::RouteWeight>> TransportRouter::GetBusEdges(const TransportCatalogue& tc, const Bus& bus) const {
+
+		std::vector<graph::Edge<RouteWeight>> v_edges;
+		const int count_stops = bus.stops.size();
+		double sum_distance = 0.;
 			
-			for (int i = 0; i < (count_stops - 1); ++i) {
+		for (int i = 0; i < (count_stops - 1); ++i) {
 
-				for (int j = (i + 1); j < count_stops; ++j) {
-					sum_distance += tc.GetDistanceBetweenStops(bus->stops[j - 1], bus->stops[j]);
-					graph_ptr_->AddEdge({ um_vertexes_of_stops_.at(bus->stops[i]->name) + 1, 
-									 um_vertexes_of_stops_.at(bus->stops[j]->name), 
-									 { bus->name, CalculateWeight(sum_distance), false, (j - i) } 
-					});
+			for (int j = (i + 1); j < count_stops; ++j) {
+				sum_distance += tc.GetDistanceBetweenStops(bus.stops[j - 1], bus.stops[j]);
+				v_edges.push_back({ um_vertexes_of_stops_.at(bus.stops[i]->name) + 1, 
+								 um_vertexes_of_stops_.at(bus.stops[j]->name), 
+								 { bus.json_name, CalculateWeight(sum_distance), false, (j - i) } 
+				});
 
-				}
-				// для новой точки рассчет сначала
-				sum_distance = 0.;
 			}
+			// для новой точки рассчет сначала
+			sum_distance = 0.;
+		}
 
-			// если не кольцевой маршрут простроим ребра в обратную сторону
-			if (!bus->is_roundtrip) {
-				for (int i = (count_stops - 1); i > 0 ; --i) {
+		// если не кольцевой маршрут простроим ребра в обратную сторону
+		if (!bus.is_roundtrip) {
+			for (int i = (count_stops - 1); i > 0 ; --i) {
 
-					for (int j = (i - 1); j >= 0; --j) {
-						sum_distance += tc.GetDistanceBetweenStops(bus->stops[j + 1], bus->stops[j]);
-						graph_ptr_->AddEdge({ um_vertexes_of_stops_.at(bus->stops[i]->name) + 1,
-										 um_vertexes_of_stops_.at(bus->stops[j]->name),
-										 { bus->name, CalculateWeight(sum_distance), false, (i - j) }
-							});
+				for (int j = (i - 1); j >= 0; --j) {
+					sum_distance += tc.GetDistanceBetweenStops(bus.stops[j + 1], bus.stops[j]);
+					v_edges.push_back({ um_vertexes_of_stops_.at(bus.stops[i]->name) + 1,
+									 um_vertexes_of_stops_.at(bus.stops[j]->name),
+									 { bus.json_name, CalculateWeight(sum_distance), false, (i - j) }
+						});
 
-					}
-					// для новой точки рассчет сначала
-					sum_distance = 0.;
 				}
+				// для новой точки рассчет сначала
+				sum_distance = 0.;
 			}
-
 		}
 
+		return v_edges;
+
 	}
 
-	double TransportRouter::CalculateWeight(double distance) {
+	double TransportRouter::CalculateWeight(double distance) const {
 		static const size_t METERS_TO_KM = 1000;
 		static const double HOURS_TO_MINETS = 60;
 
 		return ((distance / METERS_TO_KM) / bus_velocity_) * HOURS_TO_MINETS;
 	}
 
-	void TransportRouter::SetRouter() {
-		router_ptr_ = std::make_unique<graph::Router<RouteWeight>>(*graph_ptr_);
+	double TransportRouter::CalculateWalkTime(double distance) const {
+		static const size_t METERS_TO_KM = 1000;
+		static const double HOURS_TO_MINETS = 60;
+
+		return ((distance / METERS_TO_KM) / pedestrian_velocity_) * HOURS_TO_MINETS;
+	}
+
+	void TransportRouter::SetRouter(TaskPool& pool) {
+		router_ptr_ = std::make_unique<graph::Router<RouteWeight>>(*graph_ptr_, [&pool](size_t count, const auto& fn) {
+			pool.ParallelFor(count, fn);
+		});
 	}
 
 } // namespace transport_catalog
\ No newline at end of file
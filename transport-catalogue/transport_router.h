@@ -2,6 +2,7 @@
 
 #include "graph.h"
 #include "router.h"
+#include "task_pool.h"
 #include "transport_catalogue.h"
 
 #include <string>
@@ -17,10 +18,11 @@ namespace transport_catalog {
 	public:
 
 		struct RouteWeight {
-			std::string_view name = "";
+			std::string_view json_name = ""; // имя остановки или автобуса, готовое к выводу в JSON (Stop::json_name, Bus::json_name)
 			double weight = 0;
 			bool is_waiting = false;
 			int span_count = 0;
+			bool is_walking = false; // пеший участок пути (только в ответах на запросы Journey)
 
 			bool operator<(const RouteWeight& rhs) const {
 				return weight < rhs.weight;
@@ -32,7 +34,7 @@ namespace transport_catalog {
 
 			RouteWeight operator+(const RouteWeight& rhs) const {
 				return RouteWeight{
-							rhs.name,
+							rhs.json_name,
 							weight + rhs.weight,
 							is_waiting == rhs.is_waiting,
 							span_count + rhs.span_count
@@ -50,18 +52,27 @@ namespace transport_catalog {
 
 		void SetWaitTime(size_t time);
 		void SetVelocity(double velocity);
+		void SetPedestrianVelocity(double velocity);
+		void SetMaxWalkDistance(double distance);
 
 		double GetWaitTime() const;
 		double GetVelocity() const;
+		double GetPedestrianVelocity() const;
+		double GetMaxWalkDistance() const;
 
-		void BuildGraph(const TransportCatalogue& tc);
-		std::optional<RouteInfoResponse> GetRouteInfo(const std::string& stop_from, const std::string& stop_to);
+		// строит граф и маршрутизатор на потоках пула, номера ребер не зависят от числа потоков
+		void BuildGraph(const TransportCatalogue& tc, TaskPool& pool);
+		std::optional<RouteInfoResponse> GetRouteInfo(const std::string& stop_from, const std::string& stop_to) const;
+		// строит путь между произвольными точками: пешком до остановки, на автобусах, пешком от остановки
+		std::optional<RouteInfoResponse> GetJourneyInfo(const TransportCatalogue& tc, geo::Coordinates from, geo::Coordinates to) const;
 
 	private:
 		using CurrentGraph = graph::DirectedWeightedGraph<RouteWeight>;
 
 		double bus_wait_time_ = 0; // время ожидания автобуса в минутах
 		double bus_velocity_ = 0; // скорость автобуса км/ч
+		double pedestrian_velocity_ = 5.; // скорость пешехода км/ч
+		double max_walk_distance_ = 1000.; // наибольшее расстояние, которое готовы пройти пешком, в метрах
 
 		std::unordered_map<std::string_view, graph::VertexId> um_vertexes_of_stops_; // вершины входа в ожидание по остановкам
 		std::unique_ptr<CurrentGraph> graph_ptr_;
@@ -69,12 +80,16 @@ namespace transport_catalog {
 
 		// добавляет ребра остановок (ожиданий)
 		void AddEdgeStops(const std::unordered_map<std::string_view, Stop*> all_stops);
-		// добавляет ребра поездок
-		void AddEdgeBuses(const TransportCatalogue& tc);
+		// добавляет ребра поездок: ребра автобусов считаются параллельно и добавляются в порядке автобусов
+		void AddEdgeBuses(const TransportCatalogue& tc, TaskPool& pool);
+		// возвращает ребра поездок одного автобуса
+		std::vector<graph::Edge<RouteWeight>> GetBusEdges(const TransportCatalogue& tc, const Bus& bus) const;
 		// рассчитывает вес
-		double CalculateWeight(double distance);
+		double CalculateWeight(double distance) const;
+		// рассчитывает время пешего пути в минутах
+		double CalculateWalkTime(double distance) const;
 		// устанавливает указатель на роутер
-		void SetRouter();
+		void SetRouter(TaskPool& pool);
 	};
 
 } // namespace transport_catalog
\ No newline at end of file
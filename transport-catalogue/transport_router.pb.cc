@@ -23,9 +23,12 @@ namespace _pbi = _pb::internal;
 namespace transport_catalog_serialize {
 PROTOBUF_CONSTEXPR RouterSettings::RouterSettings(
     ::_pbi::ConstantInitialized): _impl_{
-    /*decltype(_impl_.bus_wait_time_)*/0
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.bus_wait_time_)*/0
   , /*decltype(_impl_.bus_velocity_)*/0
-  , /*decltype(_impl_._cached_size_)*/{}} {}
+  , /*decltype(_impl_.pedestrian_velocity_)*/0
+  , /*decltype(_impl_.max_walk_distance_)*/0} {}
 struct RouterSettingsDefaultTypeInternal {
   PROTOBUF_CONSTEXPR RouterSettingsDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -41,7 +44,7 @@ static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_trans
 static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_transport_5frouter_2eproto = nullptr;
 
 const uint32_t TableStruct_transport_5frouter_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
-  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::transport_catalog_serialize::RouterSettings, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::transport_catalog_serialize::RouterSettings, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
@@ -49,9 +52,15 @@ const uint32_t TableStruct_transport_5frouter_2eproto::offsets[] PROTOBUF_SECTIO
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::transport_catalog_serialize::RouterSettings, _impl_.bus_wait_time_),
   PROTOBUF_FIELD_OFFSET(::transport_catalog_serialize::RouterSettings, _impl_.bus_velocity_),
+  PROTOBUF_FIELD_OFFSET(::transport_catalog_serialize::RouterSettings, _impl_.pedestrian_velocity_),
+  PROTOBUF_FIELD_OFFSET(::transport_catalog_serialize::RouterSettings, _impl_.max_walk_distance_),
+  ~0u,
+  ~0u,
+  0,
+  1,
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
-  { 0, -1, -1, sizeof(::transport_catalog_serialize::RouterSettings)},
+  { 0, 10, -1, sizeof(::transport_catalog_serialize::RouterSettings)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
@@ -60,13 +69,15 @@ static const ::_pb::Message* const file_default_instances[] = {
 
 const char descriptor_table_protodef_transport_5frouter_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
   "\n\026transport_router.proto\022\033transport_cata"
-  "log_serialize\"=\n\016RouterSettings\022\025\n\rbus_w"
-  "ait_time\030\001 \001(\001\022\024\n\014bus_velocity\030\002 \001(\001b\006pr"
-  "oto3"
+  "log_serialize\"\255\001\n\016RouterSettings\022\025\n\rbus_"
+  "wait_time\030\001 \001(\001\022\024\n\014bus_velocity\030\002 \001(\001\022 \n"
+  "\023pedestrian_velocity\030\003 \001(\001H\000\210\001\001\022\036\n\021max_w"
+  "alk_distance\030\004 \001(\001H\001\210\001\001B\026\n\024_pedestrian_v"
+  "elocityB\024\n\022_max_walk_distanceb\006proto3"
   ;
 static ::_pbi::once_flag descriptor_table_transport_5frouter_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_transport_5frouter_2eproto = {
-    false, false, 124, descriptor_table_protodef_transport_5frouter_2eproto,
+    false, false, 237, descriptor_table_protodef_transport_5frouter_2eproto,
     "transport_router.proto",
     &descriptor_table_transport_5frouter_2eproto_once, nullptr, 0, 1,
     schemas, file_default_instances, TableStruct_transport_5frouter_2eproto::offsets,
@@ -85,6 +96,13 @@ namespace transport_catalog_serialize {
 
 class RouterSettings::_Internal {
  public:
+  using HasBits = decltype(std::declval<RouterSettings>()._impl_._has_bits_);
+  static void set_has_pedestrian_velocity(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_max_walk_distance(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
 };
 
 RouterSettings::RouterSettings(::PROTOBUF_NAMESPACE_ID::Arena* arena,
@@ -97,14 +115,17 @@ RouterSettings::RouterSettings(const RouterSettings& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
   RouterSettings* const _this = this; (void)_this;
   new (&_impl_) Impl_{
-      decltype(_impl_.bus_wait_time_){}
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.bus_wait_time_){}
     , decltype(_impl_.bus_velocity_){}
-    , /*decltype(_impl_._cached_size_)*/{}};
+    , decltype(_impl_.pedestrian_velocity_){}
+    , decltype(_impl_.max_walk_distance_){}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
   ::memcpy(&_impl_.bus_wait_time_, &from._impl_.bus_wait_time_,
-    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.bus_velocity_) -
-    reinterpret_cast<char*>(&_impl_.bus_wait_time_)) + sizeof(_impl_.bus_velocity_));
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.max_walk_distance_) -
+    reinterpret_cast<char*>(&_impl_.bus_wait_time_)) + sizeof(_impl_.max_walk_distance_));
   // @@protoc_insertion_point(copy_constructor:transport_catalog_serialize.RouterSettings)
 }
 
@@ -113,9 +134,12 @@ inline void RouterSettings::SharedCtor(
   (void)arena;
   (void)is_message_owned;
   new (&_impl_) Impl_{
-      decltype(_impl_.bus_wait_time_){0}
-    , decltype(_impl_.bus_velocity_){0}
+      decltype(_impl_._has_bits_){}
     , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.bus_wait_time_){0}
+    , decltype(_impl_.bus_velocity_){0}
+    , decltype(_impl_.pedestrian_velocity_){0}
+    , decltype(_impl_.max_walk_distance_){0}
   };
 }
 
@@ -145,11 +169,19 @@ void RouterSettings::Clear() {
   ::memset(&_impl_.bus_wait_time_, 0, static_cast<size_t>(
       reinterpret_cast<char*>(&_impl_.bus_velocity_) -
       reinterpret_cast<char*>(&_impl_.bus_wait_time_)) + sizeof(_impl_.bus_velocity_));
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    ::memset(&_impl_.pedestrian_velocity_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.max_walk_distance_) -
+        reinterpret_cast<char*>(&_impl_.pedestrian_velocity_)) + sizeof(_impl_.max_walk_distance_));
+  }
+  _impl_._has_bits_.Clear();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
 const char* RouterSettings::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
 #define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
   while (!ctx->Done(&ptr)) {
     uint32_t tag;
     ptr = ::_pbi::ReadTag(ptr, &tag);
@@ -170,6 +202,24 @@ const char* RouterSettings::_InternalParse(const char* ptr, ::_pbi::ParseContext
         } else
           goto handle_unusual;
         continue;
+      // optional double pedestrian_velocity = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 25)) {
+          _Internal::set_has_pedestrian_velocity(&has_bits);
+          _impl_.pedestrian_velocity_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double max_walk_distance = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 33)) {
+          _Internal::set_has_max_walk_distance(&has_bits);
+          _impl_.max_walk_distance_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -186,6 +236,7 @@ const char* RouterSettings::_InternalParse(const char* ptr, ::_pbi::ParseContext
     CHK_(ptr != nullptr);
   }  // while
 message_done:
+  _impl_._has_bits_.Or(has_bits);
   return ptr;
 failure:
   ptr = nullptr;
@@ -219,6 +270,18 @@ uint8_t* RouterSettings::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_bus_velocity(), target);
   }
 
+  // optional double pedestrian_velocity = 3;
+  if (_internal_has_pedestrian_velocity()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(3, this->_internal_pedestrian_velocity(), target);
+  }
+
+  // optional double max_walk_distance = 4;
+  if (_internal_has_max_walk_distance()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(4, this->_internal_max_walk_distance(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -253,6 +316,19 @@ size_t RouterSettings::ByteSizeLong() const {
     total_size += 1 + 8;
   }
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional double pedestrian_velocity = 3;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double max_walk_distance = 4;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 8;
+    }
+
+  }
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -285,6 +361,16 @@ void RouterSettings::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const :
   if (raw_bus_velocity != 0) {
     _this->_internal_set_bus_velocity(from._internal_bus_velocity());
   }
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.pedestrian_velocity_ = from._impl_.pedestrian_velocity_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.max_walk_distance_ = from._impl_.max_walk_distance_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -302,9 +388,10 @@ bool RouterSettings::IsInitialized() const {
 void RouterSettings::InternalSwap(RouterSettings* other) {
   using std::swap;
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
   ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(RouterSettings, _impl_.bus_velocity_)
-      + sizeof(RouterSettings::_impl_.bus_velocity_)
+      PROTOBUF_FIELD_OFFSET(RouterSettings, _impl_.max_walk_distance_)
+      + sizeof(RouterSettings::_impl_.max_walk_distance_)
       - PROTOBUF_FIELD_OFFSET(RouterSettings, _impl_.bus_wait_time_)>(
           reinterpret_cast<char*>(&_impl_.bus_wait_time_),
           reinterpret_cast<char*>(&other->_impl_.bus_wait_time_));
@@ -179,6 +179,8 @@ class RouterSettings final :
   enum : int {
     kBusWaitTimeFieldNumber = 1,
     kBusVelocityFieldNumber = 2,
+    kPedestrianVelocityFieldNumber = 3,
+    kMaxWalkDistanceFieldNumber = 4,
   };
   // double bus_wait_time = 1;
   void clear_bus_wait_time();
@@ -198,6 +200,32 @@ class RouterSettings final :
   void _internal_set_bus_velocity(double value);
   public:
 
+  // optional double pedestrian_velocity = 3;
+  bool has_pedestrian_velocity() const;
+  private:
+  bool _internal_has_pedestrian_velocity() const;
+  public:
+  void clear_pedestrian_velocity();
+  double pedestrian_velocity() const;
+  void set_pedestrian_velocity(double value);
+  private:
+  double _internal_pedestrian_velocity() const;
+  void _internal_set_pedestrian_velocity(double value);
+  public:
+
+  // optional double max_walk_distance = 4;
+  bool has_max_walk_distance() const;
+  private:
+  bool _internal_has_max_walk_distance() const;
+  public:
+  void clear_max_walk_distance();
+  double max_walk_distance() const;
+  void set_max_walk_distance(double value);
+  private:
+  double _internal_max_walk_distance() const;
+  void _internal_set_max_walk_distance(double value);
+  public:
+
   // @@protoc_insertion_point(class_scope:transport_catalog_serialize.RouterSettings)
  private:
   class _Internal;
@@ -206,9 +234,12 @@ class RouterSettings final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
     double bus_wait_time_;
     double bus_velocity_;
-    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    double pedestrian_velocity_;
+    double max_walk_distance_;
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_transport_5frouter_2eproto;
@@ -264,6 +295,62 @@ inline void RouterSettings::set_bus_velocity(double value) {
   // @@protoc_insertion_point(field_set:transport_catalog_serialize.RouterSettings.bus_velocity)
 }
 
+// optional double pedestrian_velocity = 3;
+inline bool RouterSettings::_internal_has_pedestrian_velocity() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool RouterSettings::has_pedestrian_velocity() const {
+  return _internal_has_pedestrian_velocity();
+}
+inline void RouterSettings::clear_pedestrian_velocity() {
+  _impl_.pedestrian_velocity_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline double RouterSettings::_internal_pedestrian_velocity() const {
+  return _impl_.pedestrian_velocity_;
+}
+inline double RouterSettings::pedestrian_velocity() const {
+  // @@protoc_insertion_point(field_get:transport_catalog_serialize.RouterSettings.pedestrian_velocity)
+  return _internal_pedestrian_velocity();
+}
+inline void RouterSettings::_internal_set_pedestrian_velocity(double value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.pedestrian_velocity_ = value;
+}
+inline void RouterSettings::set_pedestrian_velocity(double value) {
+  _internal_set_pedestrian_velocity(value);
+  // @@protoc_insertion_point(field_set:transport_catalog_serialize.RouterSettings.pedestrian_velocity)
+}
+
+// optional double max_walk_distance = 4;
+inline bool RouterSettings::_internal_has_max_walk_distance() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool RouterSettings::has_max_walk_distance() const {
+  return _internal_has_max_walk_distance();
+}
+inline void RouterSettings::clear_max_walk_distance() {
+  _impl_.max_walk_distance_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline double RouterSettings::_internal_max_walk_distance() const {
+  return _impl_.max_walk_distance_;
+}
+inline double RouterSettings::max_walk_distance() const {
+  // @@protoc_insertion_point(field_get:transport_catalog_serialize.RouterSettings.max_walk_distance)
+  return _internal_max_walk_distance();
+}
+inline void RouterSettings::_internal_set_max_walk_distance(double value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.max_walk_distance_ = value;
+}
+inline void RouterSettings::set_max_walk_distance(double value) {
+  _internal_set_max_walk_distance(value);
+  // @@protoc_insertion_point(field_set:transport_catalog_serialize.RouterSettings.max_walk_distance)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
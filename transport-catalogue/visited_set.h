@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace transport_catalog {
+
+    // Множество плотных номеров (например, номеров остановок) для однократного обхода.
+    // Вместо очистки массива увеличивается номер прохода: номер считается добавленным,
+    // если его отметка равна номеру текущего прохода. Переиспользуемый объект не выделяет память
+    class VisitedSet {
+    public:
+        VisitedSet() = default;
+
+        // начинает новый проход, номера до size не требуют расширения массива
+        void Reset(size_t size) {
+            if (v_stamps_.size() < size) {
+                v_stamps_.resize(size, 0);
+            }
+            if (++epoch_ == 0) {
+                // номер прохода переполнился - старые отметки больше не отличить от новых
+                std::fill(v_stamps_.begin(), v_stamps_.end(), 0);
+                epoch_ = 1;
+            }
+        }
+
+        // добавляет номер, возвращает false, если он уже был добавлен в этом проходе
+        bool Insert(size_t index) {
+            if (index >= v_stamps_.size()) {
+                v_stamps_.resize(index + 1, 0);
+            }
+            if (v_stamps_[index] == epoch_) {
+                return false;
+            }
+            v_stamps_[index] = epoch_;
+            return true;
+        }
+
+        // проверяет, добавлен ли номер в этом проходе
+        bool Contains(size_t index) const {
+            return index < v_stamps_.size() && v_stamps_[index] == epoch_;
+        }
+
+    private:
+        std::vector<uint32_t> v_stamps_;
+        uint32_t epoch_ = 1;
+    };
+
+}   // namespace transport_catalog